@@ -0,0 +1,91 @@
+// builds and discards short-lived MyVector<long long>s with std::allocator and with MyArenaAllocator (reset after
+// every vector), and counts the calls to the global operator new each way
+// usage: ./BenchArena [vectors] [elements]   (default 1000000 40)
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+
+#include "MyArena.h"
+#include "MyVector.h"
+
+using namespace std;
+
+static size_t heapAllocations = 0;
+
+void* operator new(size_t bytes)
+{
+    ++heapAllocations;
+    void *p = malloc(bytes ? bytes : 1);
+    if (p == nullptr)
+    {
+      throw bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void *p) noexcept
+{
+    free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+    free(p);
+}
+
+// keeps the sums observable so the loops are not optimized away
+static volatile long long sink;
+
+// fills a vector of the given allocator with elements values and reads them back
+template <typename Alloc>
+void buildAndDiscard(const Alloc & alloc, size_t elements)
+{
+    MyVector<long long, Alloc> v(0, alloc);
+    for (size_t k = 0; k < elements; ++k)
+    {
+      v.push_back(static_cast<long long>(k));
+    }
+    long long sum = 0;
+    for (size_t k = 0; k < v.size(); ++k)
+    {
+      sum += v[k];
+    }
+    sink = sum;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t vectors = (argc > 1) ? strtoul(argv[1], nullptr, 10) : 1000000;
+    size_t elements = (argc > 2) ? strtoul(argv[2], nullptr, 10) : 40;
+    printf("build and discard %zu vectors of %zu long long\n", vectors, elements);
+
+    {
+      size_t before = heapAllocations;
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      for (size_t k = 0; k < vectors; ++k)
+      {
+        buildAndDiscard(allocator<long long>(), elements);
+      }
+      double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+      printf("std::allocator: %6.1f ns/vector, %zu heap allocations\n", seconds / vectors * 1e9,
+             heapAllocations - before);
+    }
+
+    {
+      size_t before = heapAllocations;
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      MyArena arena;
+      for (size_t k = 0; k < vectors; ++k)
+      {
+        buildAndDiscard(MyArenaAllocator<long long>(arena), elements);
+        arena.reset();
+      }
+      double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+      printf("arena + reset:  %6.1f ns/vector, %zu heap allocations\n", seconds / vectors * 1e9,
+             heapAllocations - before);
+    }
+    return 0;
+}
@@ -0,0 +1,102 @@
+// push_back throughput of MyVector<std::string>, against the new[]-based growth MyVector used before it moved to
+// raw storage; that version is gone from the tree, so NewArrayVector below reproduces its reserve()/push_back()
+// usage: ./BenchGrowth [elements]   (default 2000000)
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <utility>
+
+#include "MyVector.h"
+
+using namespace std;
+
+// the old growth: new[] default-constructs every spare slot, and growing move-assigns into them
+template <typename DataType>
+class NewArrayVector
+{
+  private:
+    size_t theSize;
+    size_t theCapacity;
+    DataType *data;
+
+  public:
+    NewArrayVector() :
+        theSize{0},
+        theCapacity{0},
+        data{nullptr}
+    {
+
+    }
+
+    ~NewArrayVector()
+    {
+        delete [] data;
+    }
+
+    void reserve(size_t newCapacity)
+    {
+        DataType *newArray = new DataType[newCapacity];
+        for (size_t k = 0; k < theSize; ++k)
+        {
+          newArray[k] = std::move(data[k]);
+        }
+        theCapacity = newCapacity;
+        std::swap(data, newArray);
+        delete [] newArray;
+    }
+
+    void push_back(const DataType & x)
+    {
+        if (theSize == theCapacity)
+        {
+          reserve(2 * theCapacity + 1);
+        }
+        data[theSize++] = x;
+    }
+
+    size_t size() const
+    {
+        return theSize;
+    }
+};
+
+// returns the best rate (in millions of push_backs per second) of five runs
+template <typename Vector>
+double bestRate(const string & element, size_t n)
+{
+    double best = 0.0;
+    for (int run = 0; run < 5; ++run)
+    {
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      {
+        Vector v;
+        for (size_t k = 0; k < n; ++k)
+        {
+          v.push_back(element);
+        }
+        if (v.size() != n)
+        {
+          printf("wrong size %zu\n", v.size());
+          exit(1);
+        }
+      }
+      double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+      best = max(best, n / seconds / 1e6);
+    }
+    return best;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t n = (argc > 1) ? strtoul(argv[1], nullptr, 10) : 2000000;
+    // 24 characters: longer than the small-string buffer, so every element owns a heap block
+    string element(24, 'x');
+
+    printf("push_back of a %zu-char std::string, %zu elements, best of 5\n", element.size(), n);
+    printf("new[] growth (before): %6.2f M/s\n", bestRate<NewArrayVector<string> >(element, n));
+    printf("MyVector     (after):  %6.2f M/s\n", bestRate<MyVector<string> >(element, n));
+    return 0;
+}
@@ -0,0 +1,150 @@
+// parallelSort against the parallelSort it replaced (OldParallelSort below: a value-initialized MyVector buffer, one
+// merge per pair in every round and a copy back when the rounds end in the buffer) and against std::sort, on 1, 2, 4
+// and 8 threads; every result is checked against std::sort
+// before timing, both orders are checked on 300000 ints with many duplicates and on 300000 strings, on 2 to 9 threads,
+// so runs of odd and even numbers of rounds and unequal pairs are all covered
+// usage: ./BenchParallelSort [elements]   (default 100000000); exits with 1 if an order differs
+// build with -pthread
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+
+#include "MyParallelAlgorithms.h"
+
+using namespace std;
+
+// the parallelSort before merge-path rounds
+template <typename DataType, typename Compare>
+void oldParallelSort(DataType *first, DataType *last, size_t numThreads, Compare comp)
+{
+    size_t n = last - first;
+    size_t runs = parallelThreads(n, numThreads);
+    if (runs == 1)
+    {
+      std::sort(first, last, comp);
+      return;
+    }
+
+    MyVector<size_t> bounds(runs + 1);
+    for (size_t k = 0; k <= runs; ++k)
+    {
+      bounds[k] = n * k / runs;
+    }
+    parallelSlices(runs, runs,
+        [first, &bounds, &comp](size_t begin, size_t end)
+        {
+            for (size_t k = begin; k < end; ++k)
+            {
+              std::sort(first + bounds[k], first + bounds[k + 1], comp);
+            }
+        });
+
+    MyVector<DataType> buffer(n);
+    DataType *src = first;
+    DataType *dst = buffer.begin();
+    while (runs > 1)
+    {
+      size_t pairs = (runs + 1) / 2;
+      parallelSlices(pairs, pairs,
+          [src, dst, runs, &bounds, &comp](size_t begin, size_t end)
+          {
+              for (size_t p = begin; p < end; ++p)
+              {
+                size_t lo = bounds[2 * p];
+                size_t mid = bounds[std::min(2 * p + 1, runs)];
+                size_t hi = bounds[std::min(2 * p + 2, runs)];
+                std::merge(std::make_move_iterator(src + lo), std::make_move_iterator(src + mid),
+                           std::make_move_iterator(src + mid), std::make_move_iterator(src + hi),
+                           dst + lo, comp);
+              }
+          });
+      for (size_t p = 0; p <= pairs; ++p)
+      {
+        bounds[p] = bounds[std::min(2 * p, runs)];
+      }
+      runs = pairs;
+      std::swap(src, dst);
+    }
+    if (src != first)
+    {
+      std::move(src, src + n, first);
+    }
+}
+
+static bool failed = false;
+
+static double millisSince(chrono::steady_clock::time_point start)
+{
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+// sorts copies of data with parallelSort on 2 to 9 threads and compares each with reference
+template <typename DataType>
+void checkOrders(const char *name, const MyVector<DataType> & data)
+{
+    MyVector<DataType> reference(data);
+    sort(reference.begin(), reference.end());
+    bool ok = true;
+    for (size_t threads = 2; threads <= 9; ++threads)
+    {
+      MyVector<DataType> sorted(data);
+      parallelSort(sorted, threads);
+      ok = ok && equal(sorted.begin(), sorted.end(), reference.begin());
+    }
+    printf("%-40s %s\n", name, ok ? "same order as std::sort" : "ORDER DIFFERS");
+    failed = failed || !ok;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t n = (argc > 1) ? strtoul(argv[1], nullptr, 10) : 100000000;
+    mt19937 rng(560);
+
+    MyVector<int> duplicates;
+    MyVector<string> strings;
+    for (size_t k = 0; k < 300000; ++k)
+    {
+      duplicates.push_back(static_cast<int>(rng() % 1000));
+      strings.push_back(to_string(rng()));
+    }
+    checkOrders("300000 ints in [0, 1000), 2-9 threads", duplicates);
+    checkOrders("300000 strings, 2-9 threads", strings);
+
+    MyVector<int> data;
+    data.reserve(n);
+    for (size_t k = 0; k < n; ++k)
+    {
+      data.push_back(static_cast<int>(rng()));
+    }
+    MyVector<int> reference(data);
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    sort(reference.begin(), reference.end());
+    printf("%zu random ints, %u hardware threads; std::sort %.0f ms\n", n, thread::hardware_concurrency(),
+           millisSince(start));
+
+    MyVector<int> sorted(n);
+    for (size_t threads = 1; threads <= 8; threads *= 2)
+    {
+      copy(data.begin(), data.end(), sorted.begin());
+      start = chrono::steady_clock::now();
+      oldParallelSort(sorted.begin(), sorted.end(), threads, less<int>());
+      double oldMillis = millisSince(start);
+      bool same = equal(sorted.begin(), sorted.end(), reference.begin());
+
+      copy(data.begin(), data.end(), sorted.begin());
+      start = chrono::steady_clock::now();
+      parallelSort(sorted, threads);
+      double newMillis = millisSince(start);
+      same = same && equal(sorted.begin(), sorted.end(), reference.begin());
+
+      printf("%zu threads: old parallelSort %7.0f ms, parallelSort %7.0f ms%s\n", threads, oldMillis, newMillis,
+             same ? "" : "  ORDER DIFFERS");
+      failed = failed || !same;
+    }
+    return failed ? 1 : 0;
+}
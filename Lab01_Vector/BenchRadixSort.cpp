@@ -0,0 +1,103 @@
+// times radixSort/radixSortByKey against std::sort on the same data and checks that both give the same order
+// usage: ./BenchRadixSort [elements]   (default 10000000); exits with 1 if the orders differ
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+#include "MyRadixSort.h"
+
+using namespace std;
+
+// the layout of Lab05's HashedObj<long long, size_t>, which is not part of this lab
+struct KeyedRecord
+{
+    long long key;
+    size_t value;
+};
+
+static bool failed = false;
+
+static double millisSince(chrono::steady_clock::time_point start)
+{
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+// sorts a copy of data each way and prints both times
+template <typename DataType>
+void compare(const char *name, const MyVector<DataType> & data)
+{
+    MyVector<DataType> radix(data);
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    radixSort(radix);
+    double radixMillis = millisSince(start);
+
+    MyVector<DataType> reference(data);
+    start = chrono::steady_clock::now();
+    sort(reference.begin(), reference.end());
+    double sortMillis = millisSince(start);
+
+    bool same = equal(radix.begin(), radix.end(), reference.begin());
+    failed = failed || !same;
+    printf("%-30s %7.0f / %7.0f ms%s\n", name, radixMillis, sortMillis, same ? "" : "  ORDER DIFFERS");
+}
+
+// records sort by key only, so radix sort (stable) is checked against std::stable_sort and timed against std::sort
+void compareRecords(const char *name, const MyVector<KeyedRecord> & data)
+{
+    MyVector<KeyedRecord> radix(data);
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    radixSortByKey(radix);
+    double radixMillis = millisSince(start);
+
+    MyVector<KeyedRecord> reference(data);
+    start = chrono::steady_clock::now();
+    sort(reference.begin(), reference.end(), [](const KeyedRecord & a, const KeyedRecord & b) { return a.key < b.key; });
+    double sortMillis = millisSince(start);
+
+    MyVector<KeyedRecord> stable(data);
+    stable_sort(stable.begin(), stable.end(), [](const KeyedRecord & a, const KeyedRecord & b) { return a.key < b.key; });
+    bool same = equal(radix.begin(), radix.end(), stable.begin(),
+                      [](const KeyedRecord & a, const KeyedRecord & b) { return a.key == b.key && a.value == b.value; });
+    failed = failed || !same;
+    printf("%-30s %7.0f / %7.0f ms%s\n", name, radixMillis, sortMillis, same ? "" : "  ORDER DIFFERS");
+}
+
+int main(int argc, char* argv[])
+{
+    size_t n = (argc > 1) ? strtoul(argv[1], nullptr, 10) : 10000000;
+    mt19937_64 rng(560);
+    printf("%zu elements, radix / std::sort\n", n);
+
+    MyVector<long long> full(n);
+    for (size_t k = 0; k < n; ++k)
+    {
+      full[k] = static_cast<long long>(rng());
+    }
+    compare("long long, full 64-bit range", full);
+
+    MyVector<long long> ids(n);
+    for (size_t k = 0; k < n; ++k)
+    {
+      ids[k] = static_cast<long long>(rng() % 10000000);
+    }
+    compare("long long ids < 10M", ids);
+
+    MyVector<unsigned int> small(n);
+    for (size_t k = 0; k < n; ++k)
+    {
+      small[k] = static_cast<unsigned int>(rng());
+    }
+    compare("unsigned int", small);
+
+    MyVector<KeyedRecord> records(n);
+    for (size_t k = 0; k < n; ++k)
+    {
+      records[k].key = static_cast<long long>(rng() % 1000000) - 500000;
+      records[k].value = k;
+    }
+    compareRecords("{long long key, size_t value}", records);
+    return failed ? 1 : 0;
+}
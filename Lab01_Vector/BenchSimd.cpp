@@ -0,0 +1,159 @@
+// checks the MyVectorSimd.h kernels against the plain loops, then times both on one large MyVector<int>
+// the check covers every length up to 69 (so every tail) for int, long long, float, double and unsigned, and
+// float/double data with NaN in it, where min/max must still return an index inside the vector
+// usage: ./BenchSimd [elements]   (default 10000000); exits with 1 if a check fails
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <random>
+
+#include "MyVectorSimd.h"
+
+using namespace std;
+
+static size_t failures = 0;
+
+static void expect(bool ok, const char *what, size_t n)
+{
+    if (!ok)
+    {
+      printf("mismatch: %s, n = %zu\n", what, n);
+      ++failures;
+    }
+}
+
+// compares every kernel with the plain loop on n random elements of DataType
+template <typename DataType>
+void checkKernels(mt19937 & rng, size_t n)
+{
+    typedef MyScalarKernels<DataType> Scalar;
+    MyVector<DataType> v;
+    for (size_t k = 0; k < n; ++k)
+    {
+      v.push_back(static_cast<DataType>(rng() % 50));
+    }
+    DataType x = static_cast<DataType>(rng() % 50);
+    expect(simdFind(v, x) == Scalar::find(v.begin(), n, x), "find", n);
+    expect(simdCount(v, x) == Scalar::count(v.begin(), n, x), "count", n);
+    expect(simdMinIndex(v) == (n == 0 ? 0 : Scalar::minIndex(v.begin(), n)), "minIndex", n);
+    expect(simdMaxIndex(v) == (n == 0 ? 0 : Scalar::maxIndex(v.begin(), n)), "maxIndex", n);
+    expect(simdSum(v) == Scalar::sum(v.begin(), n), "sum", n);
+    MyVector<DataType> w(v);
+    simdPrefixSum(v);
+    Scalar::prefixSum(w.begin(), n);
+    for (size_t k = 0; k < n; ++k)
+    {
+      expect(v[k] == w[k], "prefixSum", n);
+    }
+}
+
+// min/max of data with NaN in it: whichever element they settle on, the index must be inside the vector
+template <typename DataType>
+void checkNaN(mt19937 & rng, size_t n)
+{
+    MyVector<DataType> v;
+    for (size_t k = 0; k < n; ++k)
+    {
+      v.push_back(static_cast<DataType>(rng() % 1000));
+    }
+    for (size_t k = 1 + rng() % 3; k > 0; --k)
+    {
+      v[rng() % n] = numeric_limits<DataType>::quiet_NaN();
+    }
+    size_t lo = simdMinIndex(v);
+    size_t hi = simdMaxIndex(v);
+    expect(lo < n, "minIndex with NaN", n);
+    expect(hi < n, "maxIndex with NaN", n);
+}
+
+// returns the best time (in milliseconds) of five calls of f, each after an untimed call of setup
+template <typename Setup, typename Func>
+double bestMillis(Setup setup, Func f)
+{
+    double best = numeric_limits<double>::max();
+    for (int run = 0; run < 5; ++run)
+    {
+      setup();
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      f();
+      best = min(best, chrono::duration<double, milli>(chrono::steady_clock::now() - start).count());
+    }
+    return best;
+}
+
+template <typename Func>
+double bestMillis(Func f)
+{
+    return bestMillis([]() { }, f);
+}
+
+// keeps the results observable so the timed calls are not optimized away
+static volatile long long sink;
+
+int main(int argc, char* argv[])
+{
+    size_t n = (argc > 1) ? strtoul(argv[1], nullptr, 10) : 10000000;
+    mt19937 rng(560);
+
+    for (size_t len = 0; len < 70; ++len)
+    {
+      checkKernels<int>(rng, len);
+      checkKernels<long long>(rng, len);
+      checkKernels<float>(rng, len);
+      checkKernels<double>(rng, len);
+      checkKernels<unsigned>(rng, len);
+    }
+    checkKernels<int>(rng, 100003);
+    checkKernels<long long>(rng, 100003);
+    for (size_t len = 1; len < 100; ++len)
+    {
+      for (int trial = 0; trial < 20; ++trial)
+      {
+        checkNaN<float>(rng, len);
+        checkNaN<double>(rng, len);
+      }
+    }
+    // two full AVX2 blocks with a NaN in the second, where the vector kernel alone used to return 16
+    MyVector<float> sixteen(16);
+    for (size_t k = 0; k < 16; ++k)
+    {
+      sixteen[k] = static_cast<float>(k);
+    }
+    sixteen[8] = numeric_limits<float>::quiet_NaN();
+    expect(simdMinIndex(sixteen) < 16 && simdMaxIndex(sixteen) < 16, "16 floats with NaN at 8", 16);
+    printf("kernel checks: %s (avx2 %s)\n", failures == 0 ? "passed" : "FAILED", simdHasAvx2() ? "on" : "off");
+
+    typedef MyScalarKernels<int> Scalar;
+    MyVector<int> v(n);
+    for (size_t k = 0; k < n; ++k)
+    {
+      v[k] = static_cast<int>(rng() % 1000) + 1;
+    }
+    // the only 0 sits at the end, so find scans everything
+    v[n - 1] = 0;
+    printf("%zu ints, ms naive / simd, best of 5\n", n);
+    printf("find (hit at end) %6.2f / %6.2f\n",
+           bestMillis([&]() { sink = Scalar::find(v.begin(), n, 0); }),
+           bestMillis([&]() { sink = simdFind(v, 0); }));
+    printf("count             %6.2f / %6.2f\n",
+           bestMillis([&]() { sink = Scalar::count(v.begin(), n, 7); }),
+           bestMillis([&]() { sink = simdCount(v, 7); }));
+    printf("minIndex          %6.2f / %6.2f\n",
+           bestMillis([&]() { sink = Scalar::minIndex(v.begin(), n); }),
+           bestMillis([&]() { sink = simdMinIndex(v); }));
+    printf("maxIndex          %6.2f / %6.2f\n",
+           bestMillis([&]() { sink = Scalar::maxIndex(v.begin(), n); }),
+           bestMillis([&]() { sink = simdMaxIndex(v); }));
+    printf("sum               %6.2f / %6.2f\n",
+           bestMillis([&]() { sink = Scalar::sum(v.begin(), n); }),
+           bestMillis([&]() { sink = simdSum(v); }));
+    // every run scans a fresh copy, so the sums stay far from overflowing
+    MyVector<int> w;
+    printf("prefixSum         %6.2f / %6.2f\n",
+           bestMillis([&]() { w = v; }, [&]() { Scalar::prefixSum(w.begin(), n); }),
+           bestMillis([&]() { w = v; }, [&]() { simdPrefixSum(w); }));
+    return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,191 @@
+#ifndef __MYARENA_H__
+#define __MYARENA_H__
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+// a bump allocator: memory is handed out from large blocks and is only given back all at once by reset()
+// intended for short-lived scratch containers (e.g. MyVector<int, MyArenaAllocator<int> >)
+class MyArena
+{
+  private:
+    struct Block
+    {
+        Block *next;        // the next block in the chain
+        size_t size;        // the number of usable bytes following the block header
+    };
+
+    Block *first;           // the first block of the chain; kept across reset()
+    Block *current;         // the block allocations are currently served from
+    char *ptr;              // the first free byte in the current block
+    char *limit;            // one past the last usable byte in the current block
+    size_t blockSize;       // the default number of usable bytes in a new block
+    size_t numBlocks;       // the number of blocks obtained from the system
+    size_t numAllocations;  // the number of allocate() calls served since the last reset()
+
+    static char* blockBegin(Block *b)
+    {
+        return reinterpret_cast<char*>(b) + sizeof(Block);
+    }
+
+    // makes b the current block
+    void enterBlock(Block *b)
+    {
+        current = b;
+        ptr = blockBegin(b);
+        limit = ptr + b->size;
+    }
+
+    // moves on to a block that can hold at least bytes + alignment bytes
+    // a block left over from before the last reset() is reused if it is large enough
+    void nextBlock(size_t bytes, size_t alignment)
+    {
+        size_t needed = bytes + alignment;
+        if (current != nullptr && current->next != nullptr && current->next->size >= needed)
+        {
+          enterBlock(current->next);
+          return;
+        }
+        size_t size = (needed > blockSize) ? needed : blockSize;
+        Block *b = static_cast<Block*>(::operator new(sizeof(Block) + size));
+        b->size = size;
+        ++numBlocks;
+        if (current == nullptr)
+        {
+          b->next = nullptr;
+          first = b;
+        }
+        else
+        {
+          b->next = current->next;
+          current->next = b;
+        }
+        enterBlock(b);
+    }
+
+  public:
+
+    explicit MyArena(size_t initBlockSize = 64 * 1024) :
+        first{nullptr},
+        current{nullptr},
+        ptr{nullptr},
+        limit{nullptr},
+        blockSize{initBlockSize},
+        numBlocks{0},
+        numAllocations{0}
+    {
+
+    }
+
+    MyArena(const MyArena & rhs) = delete;
+    MyArena & operator= (const MyArena & rhs) = delete;
+
+    // releases every block back to the system
+    ~MyArena()
+    {
+        while (first != nullptr)
+        {
+          Block *next = first->next;
+          ::operator delete(first);
+          first = next;
+        }
+    }
+
+    // returns bytes of storage aligned to alignment (a power of two)
+    void* allocate(size_t bytes, size_t alignment)
+    {
+        size_t pad = (alignment - reinterpret_cast<size_t>(ptr) % alignment) % alignment;
+        if (ptr == nullptr || bytes + pad > static_cast<size_t>(limit - ptr))
+        {
+          nextBlock(bytes, alignment);
+          pad = (alignment - reinterpret_cast<size_t>(ptr) % alignment) % alignment;
+        }
+        char *p = ptr + pad;
+        ptr = p + bytes;
+        ++numAllocations;
+        return p;
+    }
+
+    // gives back storage; only the most recent allocation can actually be reclaimed before reset()
+    void deallocate(void *p, size_t bytes)
+    {
+        if (static_cast<char*>(p) + bytes == ptr)
+        {
+          ptr = static_cast<char*>(p);
+        }
+    }
+
+    // invalidates every allocation in O(1); the blocks are kept and reused by later allocations
+    void reset()
+    {
+        if (first != nullptr)
+        {
+          enterBlock(first);
+        }
+        numAllocations = 0;
+    }
+
+    // returns the number of blocks obtained from the system so far
+    size_t blocks() const
+    {
+        return numBlocks;
+    }
+
+    // returns the number of allocations served since the last reset()
+    size_t allocations() const
+    {
+        return numAllocations;
+    }
+
+};
+
+// the allocator interface used by MyVector on top of a MyArena
+// all copies share the arena; the arena must outlive every container using it
+template <typename T>
+class MyArenaAllocator
+{
+  public:
+    typedef T value_type;
+
+    MyArena *arena;     // the arena that provides the storage
+
+    explicit MyArenaAllocator(MyArena & a) :
+        arena{&a}
+    {
+
+    }
+
+    template <typename U>
+    MyArenaAllocator(const MyArenaAllocator<U> & rhs) :
+        arena{rhs.arena}
+    {
+
+    }
+
+    T* allocate(size_t n)
+    {
+        return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T *p, size_t n)
+    {
+        arena->deallocate(p, n * sizeof(T));
+    }
+
+    template <typename U>
+    bool operator== (const MyArenaAllocator<U> & rhs) const
+    {
+        return arena == rhs.arena;
+    }
+
+    template <typename U>
+    bool operator!= (const MyArenaAllocator<U> & rhs) const
+    {
+        return !(*this == rhs);
+    }
+
+};
+
+
+#endif // __MYARENA_H__
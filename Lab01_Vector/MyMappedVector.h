@@ -0,0 +1,240 @@
+#ifndef __MYMAPPEDVECTOR_H__
+#define __MYMAPPEDVECTOR_H__
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// how MyMappedVector maps its file
+// MAPPED_READ_ONLY: the mapping is shared and cannot be written to, so only const access to the data elements is given
+// MAPPED_COPY_ON_WRITE: writes go to private copies of the touched pages and never reach the file
+enum MyMapMode { MAPPED_READ_ONLY, MAPPED_COPY_ON_WRITE };
+
+// a vector stored in a file and opened through mmap without any parsing
+// the file holds a fixed-size header followed by the raw data elements; use store() to write one
+// DataType must be trivially copyable, and files are only portable between builds with the same layout of DataType
+template <typename DataType, MyMapMode Mode = MAPPED_READ_ONLY>
+class MyMappedVector
+{
+    static_assert(std::is_trivially_copyable<DataType>::value, "MyMappedVector stores data elements as raw bytes");
+    static_assert(alignof(DataType) <= 64, "the data elements start 64 bytes into the file");
+
+  public:
+
+    // the type handed out by operator[] and the iterators: const DataType unless the mapping is writable
+    typedef typename std::conditional<Mode == MAPPED_READ_ONLY, const DataType, DataType>::type ElementType;
+
+  private:
+
+    struct Header
+    {
+        char magic[8];          // "MYVECTOR"
+        uint64_t elementSize;   // sizeof(DataType) of the writer
+        uint64_t count;         // the number of data elements following the header
+        char reserved[40];      // pads the header to 64 bytes so the data elements stay aligned
+    };
+
+    static const char* magicString()
+    {
+        return "MYVECTOR";
+    }
+
+    void *mapping;              // the start of the mapped file; nullptr if nothing is open
+    size_t mappedBytes;         // the length of the mapping
+    ElementType *data;          // the first data element inside the mapping
+    size_t theSize;             // the number of data elements
+
+  public:
+
+    // default constructor; nothing is mapped until open() succeeds
+    MyMappedVector() :
+        mapping{nullptr},
+        mappedBytes{0},
+        data{nullptr},
+        theSize{0}
+    {
+
+    }
+
+    MyMappedVector(const MyMappedVector & rhs) = delete;
+    MyMappedVector & operator= (const MyMappedVector & rhs) = delete;
+
+    // move constructor
+    MyMappedVector(MyMappedVector && rhs) :
+        mapping{rhs.mapping},
+        mappedBytes{rhs.mappedBytes},
+        data{rhs.data},
+        theSize{rhs.theSize}
+    {
+        rhs.mapping = nullptr;
+        rhs.mappedBytes = 0;
+        rhs.data = nullptr;
+        rhs.theSize = 0;
+    }
+
+    // move assignment
+    MyMappedVector & operator= (MyMappedVector && rhs)
+    {
+        std::swap(mapping, rhs.mapping);
+        std::swap(mappedBytes, rhs.mappedBytes);
+        std::swap(data, rhs.data);
+        std::swap(theSize, rhs.theSize);
+        return *this;
+    }
+
+    // destructor
+    ~MyMappedVector()
+    {
+        close();
+    }
+
+    // writes n data elements starting at first into fileName, replacing its content
+    // returns true on success, false if the file cannot be written
+    static bool store(const std::string & fileName, const DataType *first, size_t n)
+    {
+        Header header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, magicString(), sizeof(header.magic));
+        header.elementSize = sizeof(DataType);
+        header.count = n;
+        std::ofstream outFile(fileName.c_str(), std::ios::binary | std::ios::trunc);
+        if (!outFile.is_open())
+        {
+          return false;
+        }
+        outFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        if (n > 0)
+        {
+          outFile.write(reinterpret_cast<const char*>(first), n * sizeof(DataType));
+        }
+        outFile.close();
+        return !outFile.fail();
+    }
+
+    // writes the data elements of vec (e.g. a MyVector<DataType>) into fileName
+    template <typename VectorType>
+    static bool store(const std::string & fileName, const VectorType & vec)
+    {
+        return store(fileName, vec.begin(), vec.size());
+    }
+
+    // maps fileName as Mode says; any previous mapping is closed first
+    // returns false if the file cannot be mapped or was not written by store() for this DataType
+    bool open(const std::string & fileName)
+    {
+        close();
+        int fd = ::open(fileName.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+          return false;
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(Header))
+        {
+          ::close(fd);
+          return false;
+        }
+        size_t bytes = static_cast<size_t>(info.st_size);
+        int flags = (Mode == MAPPED_READ_ONLY) ? MAP_SHARED : MAP_PRIVATE;
+        int prot = (Mode == MAPPED_READ_ONLY) ? PROT_READ : (PROT_READ | PROT_WRITE);
+        void *p = mmap(nullptr, bytes, prot, flags, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED)
+        {
+          return false;
+        }
+        const Header *header = static_cast<const Header*>(p);
+        if (std::memcmp(header->magic, magicString(), sizeof(header->magic)) != 0 ||
+            header->elementSize != sizeof(DataType) ||
+            header->count > (bytes - sizeof(Header)) / sizeof(DataType))
+        {
+          munmap(p, bytes);
+          return false;
+        }
+        mapping = p;
+        mappedBytes = bytes;
+        data = reinterpret_cast<ElementType*>(static_cast<char*>(p) + sizeof(Header));
+        theSize = header->count;
+        return true;
+    }
+
+    // unmaps the file; the vector becomes empty
+    void close()
+    {
+        if (mapping != nullptr)
+        {
+          munmap(mapping, mappedBytes);
+        }
+        mapping = nullptr;
+        mappedBytes = 0;
+        data = nullptr;
+        theSize = 0;
+    }
+
+    // checks whether a file is currently mapped
+    bool isOpen() const
+    {
+        return mapping != nullptr;
+    }
+
+    // data access operator (without bound checking)
+    // a MAPPED_READ_ONLY vector returns a const reference here too
+    ElementType & operator[] (size_t index)
+    {
+        return data[index];
+    }
+
+    const DataType & operator[](size_t index) const
+    {
+        return data[index];
+    }
+
+    // check if the vector is empty; return TRUE if the vector is empty
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    // returns the size of the vector
+    size_t size() const
+    {
+        return theSize;
+    }
+
+    // iterator implementation
+
+    typedef ElementType* iterator;
+    typedef const DataType* const_iterator;
+
+    iterator begin()
+    {
+        return data;
+    }
+
+    const_iterator begin() const
+    {
+        return data;
+    }
+
+    iterator end()
+    {
+        return data + size();
+    }
+
+    const_iterator end() const
+    {
+        return data + size();
+    }
+
+};
+
+
+#endif // __MYMAPPEDVECTOR_H__
@@ -0,0 +1,313 @@
+#ifndef __MYPARALLELALGORITHMS_H__
+#define __MYPARALLELALGORITHMS_H__
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "MyVector.h"
+
+// multi-threaded sort, transform and for_each over contiguous ranges (e.g. the data elements of a MyVector)
+// numThreads == 0 means one thread per hardware thread; ranges below parallelCutoff() run on the calling thread
+// programs using these need to be linked with -pthread
+
+// the range size below which splitting the work across threads costs more than it saves
+inline size_t parallelCutoff()
+{
+    return 1 << 15;
+}
+
+// the number of threads to use for n data elements when numThreads were asked for
+inline size_t parallelThreads(size_t n, size_t numThreads)
+{
+    if (numThreads == 0)
+    {
+      numThreads = std::thread::hardware_concurrency();
+    }
+    size_t most = n / parallelCutoff();
+    numThreads = std::min(numThreads, most);
+    return (numThreads == 0) ? 1 : numThreads;
+}
+
+// runs task(begin, end) over numThreads contiguous slices of [0, n); the calling thread takes the last slice
+template <typename Task>
+void parallelSlices(size_t n, size_t numThreads, Task task)
+{
+    MyVector<std::thread> workers;
+    workers.reserve(numThreads);
+    for (size_t t = 0; t + 1 < numThreads; ++t)
+    {
+      workers.emplace_back(task, n * t / numThreads, n * (t + 1) / numThreads);
+    }
+    task(n * (numThreads - 1) / numThreads, n);
+    for (size_t t = 0; t < workers.size(); ++t)
+    {
+      workers[t].join();
+    }
+}
+
+// applies f to every data element in [first, last)
+template <typename DataType, typename Function>
+void parallelForEach(DataType *first, DataType *last, Function f, size_t numThreads = 0)
+{
+    size_t n = last - first;
+    parallelSlices(n, parallelThreads(n, numThreads),
+        [first, &f](size_t begin, size_t end)
+        {
+            for (size_t k = begin; k < end; ++k)
+            {
+              f(first[k]);
+            }
+        });
+}
+
+// writes f(x) for every data element x in [first, last) to the range starting at out; out may equal first
+template <typename DataType, typename OutType, typename Function>
+void parallelTransform(const DataType *first, const DataType *last, OutType *out, Function f, size_t numThreads = 0)
+{
+    size_t n = last - first;
+    parallelSlices(n, parallelThreads(n, numThreads),
+        [first, out, &f](size_t begin, size_t end)
+        {
+            for (size_t k = begin; k < end; ++k)
+            {
+              out[k] = f(first[k]);
+            }
+        });
+}
+
+// returns how many of the first k data elements of the merge of the sorted ranges a (m elements) and b (nb elements)
+// come from a, the rest coming from b; equal data elements are taken from a first, as std::merge does
+// this is where a merge of m + nb data elements can be cut at output position k, so threads can merge disjoint parts
+template <typename DataType, typename Compare>
+size_t mergeCoRank(size_t k, const DataType *a, size_t m, const DataType *b, size_t nb, Compare & comp)
+{
+    size_t lo = (k > nb) ? k - nb : 0;
+    size_t hi = std::min(k, m);
+    while (lo < hi)
+    {
+      // with i elements from a, a[i] must not belong before b[k - i - 1]; otherwise more come from a
+      size_t i = lo + (hi - lo) / 2;
+      if (!comp(b[k - i - 1], a[i]))
+      {
+        lo = i + 1;
+      }
+      else
+      {
+        hi = i;
+      }
+    }
+    return lo;
+}
+
+// puts x into out by moving: constructs it there if out is raw storage, assigns to it otherwise
+template <typename DataType>
+void mergePut(DataType *out, DataType & x, std::true_type)
+{
+    new (out) DataType(std::move(x));
+}
+
+template <typename DataType>
+void mergePut(DataType *out, DataType & x, std::false_type)
+{
+    *out = std::move(x);
+}
+
+// moves the merge of the sorted ranges [a, aEnd) and [b, bEnd) to out; Construct is std::true_type if out is raw storage
+template <typename DataType, typename Compare, typename Construct>
+void mergeMoving(DataType *a, DataType *aEnd, DataType *b, DataType *bEnd, DataType *out, Compare & comp,
+                 Construct construct)
+{
+    while (a != aEnd && b != bEnd)
+    {
+      if (comp(*b, *a))
+      {
+        mergePut(out++, *b++, construct);
+      }
+      else
+      {
+        mergePut(out++, *a++, construct);
+      }
+    }
+    for ( ; a != aEnd; ++a)
+    {
+      mergePut(out++, *a, construct);
+    }
+    for ( ; b != bEnd; ++b)
+    {
+      mergePut(out++, *b, construct);
+    }
+}
+
+// one round of parallelSort: merges the runs of src (the k-th starting at bounds[k]) pairwise into dst
+// the output [0, n) is cut into numThreads equal slices, and mergeCoRank() finds where every cut falls in the pair it
+// lands in, so one long pair is merged by all threads just like many short ones are; the cuts are all found before
+// any thread starts moving data elements out of src
+template <typename DataType, typename Compare, typename Construct>
+void mergeRound(DataType *src, DataType *dst, size_t n, const MyVector<size_t> & bounds, size_t runs,
+                size_t numThreads, Compare & comp, Construct construct)
+{
+    // cuts[t] is how many data elements of the first run of its pair come before output position n * t / numThreads
+    MyVector<size_t> cuts(numThreads + 1);
+    for (size_t t = 0, p = 0; t < numThreads; ++t)
+    {
+      size_t pos = n * t / numThreads;
+      while (bounds[std::min(2 * p + 2, runs)] <= pos)
+      {
+        ++p;
+      }
+      size_t lo = bounds[2 * p];
+      size_t mid = bounds[std::min(2 * p + 1, runs)];
+      size_t hi = bounds[std::min(2 * p + 2, runs)];
+      cuts[t] = mergeCoRank(pos - lo, src + lo, mid - lo, src + mid, hi - mid, comp);
+    }
+
+    parallelSlices(numThreads, numThreads,
+        [src, dst, n, runs, numThreads, &bounds, &cuts, &comp, construct](size_t t, size_t)
+        {
+            size_t begin = n * t / numThreads;
+            size_t end = n * (t + 1) / numThreads;
+            for (size_t p = 0; 2 * p < runs; ++p)
+            {
+              size_t lo = bounds[2 * p];
+              size_t mid = bounds[std::min(2 * p + 1, runs)];
+              size_t hi = bounds[std::min(2 * p + 2, runs)];
+              if (hi <= begin || lo >= end)
+              {
+                continue;
+              }
+              size_t from = (begin > lo) ? begin - lo : 0;
+              size_t to = (end < hi) ? end - lo : hi - lo;
+              size_t aFrom = (begin > lo) ? cuts[t] : 0;
+              size_t aTo = (end < hi) ? cuts[t + 1] : mid - lo;
+              mergeMoving(src + lo + aFrom, src + lo + aTo, src + mid + (from - aFrom), src + mid + (to - aTo),
+                          dst + lo + from, comp, construct);
+            }
+        });
+}
+
+// sorts [first, last) with comp: every thread std::sort()s one run, then neighbouring runs are merged pairwise, one
+// round after another, every round split evenly across all threads by mergeRound()
+// the merges alternate between [first, last) and a scratch buffer that is never value-initialized; when the number of
+// rounds is odd the runs are sorted in the buffer, so the last round always lands in [first, last)
+// not stable; DataType must be move constructible
+// numThreads comes before comp so that a thread count can never be taken for a comparator
+template <typename DataType, typename Compare>
+void parallelSort(DataType *first, DataType *last, size_t numThreads, Compare comp)
+{
+    size_t n = last - first;
+    size_t runs = parallelThreads(n, numThreads);
+    if (runs == 1)
+    {
+      std::sort(first, last, comp);
+      return;
+    }
+    numThreads = runs;
+    size_t rounds = 0;
+    for (size_t r = runs; r > 1; r = (r + 1) / 2)
+    {
+      ++rounds;
+    }
+
+    // bounds[k] is where the k-th sorted run starts
+    MyVector<size_t> bounds(runs + 1);
+    for (size_t k = 0; k <= runs; ++k)
+    {
+      bounds[k] = n * k / runs;
+    }
+    DataType *buffer = std::allocator<DataType>().allocate(n);
+    bool startInBuffer = (rounds % 2 == 1);
+    parallelSlices(runs, runs,
+        [first, buffer, startInBuffer, &bounds, &comp](size_t begin, size_t end)
+        {
+            for (size_t k = begin; k < end; ++k)
+            {
+              DataType *run = first + bounds[k];
+              DataType *runEnd = first + bounds[k + 1];
+              if (startInBuffer)
+              {
+                std::uninitialized_copy(std::make_move_iterator(run), std::make_move_iterator(runEnd),
+                                        buffer + bounds[k]);
+                run = buffer + bounds[k];
+                runEnd = buffer + bounds[k + 1];
+              }
+              std::sort(run, runEnd, comp);
+            }
+        });
+
+    // the buffer holds constructed data elements from the end of the first round on
+    DataType *src = startInBuffer ? buffer : first;
+    DataType *dst = startInBuffer ? first : buffer;
+    for (size_t round = 0; round < rounds; ++round)
+    {
+      if (round == 0 && dst == buffer)
+      {
+        mergeRound(src, dst, n, bounds, runs, numThreads, comp, std::true_type());
+      }
+      else
+      {
+        mergeRound(src, dst, n, bounds, runs, numThreads, comp, std::false_type());
+      }
+      size_t pairs = (runs + 1) / 2;
+      for (size_t p = 0; p <= pairs; ++p)
+      {
+        bounds[p] = bounds[std::min(2 * p, runs)];
+      }
+      runs = pairs;
+      std::swap(src, dst);
+    }
+
+    if (!std::is_trivially_destructible<DataType>::value)
+    {
+      parallelSlices(n, numThreads,
+          [buffer](size_t begin, size_t end)
+          {
+              for (size_t k = begin; k < end; ++k)
+              {
+                buffer[k].~DataType();
+              }
+          });
+    }
+    std::allocator<DataType>().deallocate(buffer, n);
+}
+
+template <typename DataType>
+void parallelSort(DataType *first, DataType *last, size_t numThreads = 0)
+{
+    parallelSort(first, last, numThreads, std::less<DataType>());
+}
+
+// the MyVector front ends
+
+template <typename DataType, typename Alloc, typename Growth, typename Compare>
+void parallelSort(MyVector<DataType, Alloc, Growth> & v, size_t numThreads, Compare comp)
+{
+    parallelSort(v.begin(), v.end(), numThreads, comp);
+}
+
+template <typename DataType, typename Alloc, typename Growth>
+void parallelSort(MyVector<DataType, Alloc, Growth> & v, size_t numThreads = 0)
+{
+    parallelSort(v.begin(), v.end(), numThreads, std::less<DataType>());
+}
+
+template <typename DataType, typename Alloc, typename Growth, typename Function>
+void parallelForEach(MyVector<DataType, Alloc, Growth> & v, Function f, size_t numThreads = 0)
+{
+    parallelForEach(v.begin(), v.end(), f, numThreads);
+}
+
+// transforms v in place
+template <typename DataType, typename Alloc, typename Growth, typename Function>
+void parallelTransform(MyVector<DataType, Alloc, Growth> & v, Function f, size_t numThreads = 0)
+{
+    parallelTransform(v.begin(), v.end(), v.begin(), f, numThreads);
+}
+
+
+#endif // __MYPARALLELALGORITHMS_H__
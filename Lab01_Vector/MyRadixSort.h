@@ -0,0 +1,122 @@
+#ifndef __MYRADIXSORT_H__
+#define __MYRADIXSORT_H__
+
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include "MyVector.h"
+
+// LSD radix sort over integer keys, radixBits() bits per pass
+//
+//   radixSort(v)             sorts a MyVector of signed or unsigned integers
+//   radixSortBy(v, key)      sorts any MyVector by the integer key(x), e.g. [](const Edge & e) { return e.src; }
+//   radixSortByKey(v)        sorts data elements that carry a public integer member "key" (e.g. HashedObj<long long, V>)
+//
+// all three are stable; DataType must be default constructible for the scatter buffer
+// passes in which every key has the same byte are skipped, so small key ranges cost only a few passes
+
+// the digit width; 2^11 counters still fit in L1, and 64-bit keys take 6 passes instead of 8 with bytes
+inline size_t radixBits()
+{
+    return 11;
+}
+
+// the digit of key used by pass p; flipping the sign bit orders negative keys before non-negative ones
+template <typename KeyType>
+size_t radixDigit(KeyType key, size_t pass)
+{
+    typedef typename std::make_unsigned<KeyType>::type UnsignedKey;
+    UnsignedKey u = static_cast<UnsignedKey>(key);
+    if (std::numeric_limits<KeyType>::is_signed)
+    {
+      u ^= static_cast<UnsignedKey>(UnsignedKey(1) << (8 * sizeof(KeyType) - 1));
+    }
+    return static_cast<size_t>((u >> (radixBits() * pass)) & ((size_t(1) << radixBits()) - 1));
+}
+
+template <typename DataType, typename KeyFunc>
+void radixSortBy(DataType *first, DataType *last, KeyFunc key)
+{
+    typedef typename std::decay<decltype(key(*first))>::type KeyType;
+    static_assert(std::is_integral<KeyType>::value, "radix sort needs integer keys");
+    const size_t passes = (8 * sizeof(KeyType) + radixBits() - 1) / radixBits();
+    const size_t buckets = size_t(1) << radixBits();
+    const size_t n = last - first;
+
+    // below this size a comparison sort wins over clearing and scanning the counters of every pass
+    if (n < 64)
+    {
+      std::stable_sort(first, last,
+          [&key](const DataType & a, const DataType & b)
+          {
+              return key(a) < key(b);
+          });
+      return;
+    }
+
+    // one read of the input builds the histograms of every pass
+    MyVector<size_t> counts(buckets * passes);
+    for (size_t i = 0; i < n; ++i)
+    {
+      KeyType k = key(first[i]);
+      for (size_t p = 0; p < passes; ++p)
+      {
+        ++counts[buckets * p + radixDigit(k, p)];
+      }
+    }
+
+    MyVector<DataType> buffer(n);
+    DataType *src = first;
+    DataType *dst = buffer.begin();
+    for (size_t p = 0; p < passes; ++p)
+    {
+      size_t *count = counts.begin() + buckets * p;
+      if (count[radixDigit(key(src[0]), p)] == n)
+      {
+        continue;
+      }
+
+      // turn the counts into the first output slot of every digit
+      size_t offset = 0;
+      for (size_t d = 0; d < buckets; ++d)
+      {
+        size_t c = count[d];
+        count[d] = offset;
+        offset += c;
+      }
+      for (size_t i = 0; i < n; ++i)
+      {
+        dst[count[radixDigit(key(src[i]), p)]++] = std::move(src[i]);
+      }
+      std::swap(src, dst);
+    }
+    if (src != first)
+    {
+      std::move(src, src + n, first);
+    }
+}
+
+// the MyVector front ends
+
+template <typename DataType, typename Alloc, typename Growth, typename KeyFunc>
+void radixSortBy(MyVector<DataType, Alloc, Growth> & v, KeyFunc key)
+{
+    radixSortBy(v.begin(), v.end(), key);
+}
+
+template <typename DataType, typename Alloc, typename Growth>
+void radixSort(MyVector<DataType, Alloc, Growth> & v)
+{
+    radixSortBy(v.begin(), v.end(), [](DataType x) { return x; });
+}
+
+template <typename DataType, typename Alloc, typename Growth>
+void radixSortByKey(MyVector<DataType, Alloc, Growth> & v)
+{
+    radixSortBy(v.begin(), v.end(), [](const DataType & x) -> decltype(x.key) { return x.key; });
+}
+
+
+#endif // __MYRADIXSORT_H__
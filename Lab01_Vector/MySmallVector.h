@@ -0,0 +1,289 @@
+#ifndef __MYSMALLVECTOR_H__
+#define __MYSMALLVECTOR_H__
+
+#include <algorithm>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// a vector that keeps its first N data elements inside the object and only moves to the heap beyond that
+// offers the same element interface as MyVector; meant for short-lived scratch vectors
+template <typename DataType, size_t N>
+class MySmallVector
+{
+    static_assert(N > 0, "MySmallVector needs at least one inline slot");
+
+  private:
+    size_t theSize;                         // the number of data elements the vector is currently holding
+    size_t theCapacity;                     // maximum data elements the vector can hold without growing
+    DataType *data;                         // address of the data storage; points at inlineData until it spills
+    typename std::aligned_storage<sizeof(DataType), alignof(DataType)>::type inlineData[N];   // the inline slots
+
+    DataType* inlineBegin()
+    {
+        return reinterpret_cast<DataType*>(inlineData);
+    }
+
+    // checks whether the data elements still live in the inline slots
+    bool isInline() const
+    {
+        return data == reinterpret_cast<const DataType*>(inlineData);
+    }
+
+    // destroys the data elements and releases heap storage, leaving an empty vector on the inline slots
+    void release()
+    {
+        clear();
+        if (!isInline())
+        {
+          ::operator delete(data);
+        }
+        data = inlineBegin();
+        theCapacity = N;
+    }
+
+    // allocates heap storage for n data elements without constructing any of them
+    static DataType* allocate(size_t n)
+    {
+        return static_cast<DataType*>(::operator new(n * sizeof(DataType)));
+    }
+
+    // moves the data elements into newArray, which holds newCapacity slots, and makes it the storage
+    void adopt(DataType *newArray, size_t newCapacity)
+    {
+        for (size_t k = 0; k < theSize; ++k)
+        {
+          new (newArray + k) DataType(std::move(data[k]));
+          data[k].~DataType();
+        }
+        if (!isInline())
+        {
+          ::operator delete(data);
+        }
+        data = newArray;
+        theCapacity = newCapacity;
+    }
+
+    // takes over the data elements of rhs, leaving rhs empty
+    void steal(MySmallVector && rhs)
+    {
+        if (rhs.isInline())
+        {
+          for (size_t k = 0; k < rhs.theSize; ++k)
+          {
+            new (data + k) DataType(std::move(rhs.data[k]));
+          }
+          theSize = rhs.theSize;
+          rhs.clear();
+        }
+        else
+        {
+          data = rhs.data;
+          theSize = rhs.theSize;
+          theCapacity = rhs.theCapacity;
+          rhs.data = rhs.inlineBegin();
+          rhs.theSize = 0;
+          rhs.theCapacity = N;
+        }
+    }
+
+  public:
+
+    // default constructor
+    MySmallVector() :
+        theSize{0},
+        theCapacity{N}
+    {
+        data = inlineBegin();
+    }
+
+    // copy constructor
+    MySmallVector(const MySmallVector & rhs) :
+        theSize{0},
+        theCapacity{N}
+    {
+        data = inlineBegin();
+        reserve(rhs.theSize);
+        for (size_t k = 0; k < rhs.theSize; ++k)
+        {
+          new (data + k) DataType(rhs.data[k]);
+        }
+        theSize = rhs.theSize;
+    }
+
+    // move constructor
+    MySmallVector(MySmallVector && rhs) :
+        theSize{0},
+        theCapacity{N}
+    {
+        data = inlineBegin();
+        steal(std::move(rhs));
+    }
+
+    // destructor
+    ~MySmallVector()
+    {
+        release();
+    }
+
+    // copy assignment
+    MySmallVector & operator= (const MySmallVector & rhs)
+    {
+        if (this != &rhs)
+        {
+          MySmallVector copy = rhs;
+          *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    // move assignment
+    MySmallVector & operator= (MySmallVector && rhs)
+    {
+        if (this != &rhs)
+        {
+          release();
+          steal(std::move(rhs));
+        }
+        return *this;
+    }
+
+    // change the size of the array; new data elements are value-initialized
+    void resize(size_t newSize)
+    {
+        reserve(newSize);
+        while (theSize > newSize)
+        {
+          pop_back();
+        }
+        while (theSize < newSize)
+        {
+          new (data + theSize++) DataType();
+        }
+    }
+
+    // makes room for at least newCapacity data elements
+    void reserve(size_t newCapacity)
+    {
+        if (newCapacity > theCapacity)
+        {
+          adopt(allocate(newCapacity), newCapacity);
+        }
+    }
+
+    // data access operator (without bound checking)
+    DataType & operator[] (size_t index)
+    {
+        return data[index];
+    }
+
+    const DataType & operator[](size_t index) const
+    {
+        return data[index];
+    }
+
+    // check if the vector is empty; return TRUE if the vector is empty
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    // remove all data elements from the vector; heap storage, if any, is kept
+    void clear()
+    {
+        while (!empty())
+        {
+          pop_back();
+        }
+    }
+
+    // returns the size of the vector
+    size_t size() const
+    {
+        return theSize;
+    }
+
+    // returns the capacity of the vector
+    size_t capacity() const
+    {
+        return theCapacity;
+    }
+
+    // construct a data element in place at the end of the vector
+    // when the vector grows, the new element is constructed before the old ones are moved,
+    // so the arguments may refer to an element of this vector
+    template <typename... Args>
+    void emplace_back(Args&&... args)
+    {
+        if (theSize == theCapacity)
+        {
+          // never below N, which also lets the compiler see that the new storage is not empty
+          size_t newCapacity = std::max<size_t>(2 * theCapacity, N);
+          DataType *newArray = allocate(newCapacity);
+          new (newArray + theSize) DataType(std::forward<Args>(args)...);
+          adopt(newArray, newCapacity);
+        }
+        else
+        {
+          new (data + theSize) DataType(std::forward<Args>(args)...);
+        }
+        ++theSize;
+    }
+
+    // insert an data element to the end of the vector
+    void push_back(const DataType & x)
+    {
+        emplace_back(x);
+    }
+
+    void push_back(DataType && x)
+    {
+        emplace_back(std::move(x));
+    }
+
+    // remove the last data element from the array
+    void pop_back()
+    {
+        data[--theSize].~DataType();
+    }
+
+    // returns the last data element from the array
+    DataType& back()
+    {
+        return data[theSize - 1];
+    }
+
+    const DataType& back() const
+    {
+        return data[theSize - 1];
+    }
+
+    // iterator implementation
+
+    typedef DataType* iterator;
+    typedef const DataType* const_iterator;
+
+    iterator begin()
+    {
+        return data;
+    }
+
+    const_iterator begin() const
+    {
+        return data;
+    }
+
+    iterator end()
+    {
+        return data + size();
+    }
+
+    const_iterator end() const
+    {
+        return data + size();
+    }
+
+};
+
+
+#endif // __MYSMALLVECTOR_H__
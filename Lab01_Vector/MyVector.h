@@ -1,47 +1,305 @@
 #ifndef __MYVECTOR_H__
 #define __MYVECTOR_H__
 
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
-template <typename DataType>
+// growth policies decide the new capacity when the vector runs out of room
+// grow() returns a capacity of at least required; record() is told about every reallocation, and allocated() about
+// every block of storage the vector obtains, the first one included
+
+// doubles the capacity (the classic 2 * capacity + 1)
+struct MyDoublingGrowth
+{
+    static size_t grow(size_t capacity, size_t required)
+    {
+        return std::max(2 * capacity + 1, required);
+    }
+
+    void record(size_t, size_t, size_t)
+    {
+
+    }
+
+    void allocated(size_t)
+    {
+
+    }
+};
+
+// grows the capacity by half; wastes less memory at the cost of more reallocations
+struct MyHalfGrowth
+{
+    static size_t grow(size_t capacity, size_t required)
+    {
+        return std::max(capacity + capacity / 2 + 1, required);
+    }
+
+    void record(size_t, size_t, size_t)
+    {
+
+    }
+
+    void allocated(size_t)
+    {
+
+    }
+};
+
+// grows the capacity by a fixed number of data elements
+template <size_t Chunk>
+struct MyChunkGrowth
+{
+    static_assert(Chunk > 0, "MyChunkGrowth needs a positive chunk size");
+
+    static size_t grow(size_t capacity, size_t required)
+    {
+        return std::max(capacity + Chunk, required);
+    }
+
+    void record(size_t, size_t, size_t)
+    {
+
+    }
+
+    void allocated(size_t)
+    {
+
+    }
+};
+
+// wraps another growth policy and keeps reallocation counters
+// read them through MyVector::growth(), e.g. v.growth().reallocations()
+template <typename Policy = MyDoublingGrowth>
+class MyTrackedGrowth
+{
+  private:
+    size_t numReallocations;    // the number of times the storage was replaced
+    size_t numBytesCopied;      // the bytes of data elements moved into new storage
+    size_t maxCapacity;         // the largest capacity the vector ever allocated
+
+  public:
+    MyTrackedGrowth() :
+        numReallocations{0},
+        numBytesCopied{0},
+        maxCapacity{0}
+    {
+
+    }
+
+    static size_t grow(size_t capacity, size_t required)
+    {
+        return Policy::grow(capacity, required);
+    }
+
+    void record(size_t oldCapacity, size_t newCapacity, size_t bytesCopied)
+    {
+        ++numReallocations;
+        numBytesCopied += bytesCopied;
+        maxCapacity = std::max(maxCapacity, std::max(oldCapacity, newCapacity));
+    }
+
+    void allocated(size_t capacity)
+    {
+        maxCapacity = std::max(maxCapacity, capacity);
+    }
+
+    size_t reallocations() const
+    {
+        return numReallocations;
+    }
+
+    size_t bytesCopied() const
+    {
+        return numBytesCopied;
+    }
+
+    // the largest capacity the vector has had, whether it was reached by growth or allocated up front
+    // (by the size constructor, a copy or reserve())
+    size_t peakCapacity() const
+    {
+        return maxCapacity;
+    }
+};
+
+// Alloc supplies the raw storage; it must provide allocate(n) and deallocate(p, n) for DataType
+// (e.g. std::allocator, or MyArenaAllocator from MyArena.h)
+// Growth picks the new capacity on reallocation (MyDoublingGrowth, MyHalfGrowth, MyChunkGrowth<n>, MyTrackedGrowth<...>)
+template <typename DataType, typename Alloc = std::allocator<DataType>, typename Growth = MyDoublingGrowth>
 class MyVector
 {
   private:
     /* data */
     size_t theSize;                         // the number of data elements the vector is currently holding
     size_t theCapacity;                     // maximum data elements the vector can hold
-    DataType *data;                         // address of the data storage
+    DataType *data;                         // address of the data storage; only the first theSize slots are constructed
+    Alloc theAllocator;                     // the allocator that owns the data storage
+    Growth theGrowth;                       // the growth policy (and its counters, if it keeps any)
+
+    // allocates raw storage for n data elements without constructing any of them
+    DataType* allocate(size_t n)
+    {
+        theGrowth.allocated(n);
+        return theAllocator.allocate(n);
+    }
+
+    // releases storage of n data elements obtained from allocate()
+    void deallocate(DataType *p, size_t n)
+    {
+        if (p != nullptr)
+        {
+          theAllocator.deallocate(p, n);
+        }
+    }
+
+    // releases the old storage and switches to newArray, which already holds the theSize data elements
+    void adoptStorage(DataType *newArray, size_t newCapacity)
+    {
+        theGrowth.record(theCapacity, newCapacity, theSize * sizeof(DataType));
+        deallocate(data, theCapacity);
+        data = newArray;
+        theCapacity = newCapacity;
+    }
+
+    // destroys the data elements in [first, last) without releasing their storage
+    // trivially destructible data elements need no work at all
+    static void destroy(DataType *first, DataType *last)
+    {
+        destroy(first, last, std::is_trivially_destructible<DataType>());
+    }
+
+    static void destroy(DataType *, DataType *, std::true_type)
+    {
+
+    }
+
+    static void destroy(DataType *first, DataType *last, std::false_type)
+    {
+        for (; first != last; ++first)
+        {
+          first->~DataType();
+        }
+    }
+
+    // trivially copyable data elements (int, long long, pointers, ...) are copied as raw bytes
+    typedef std::integral_constant<bool, std::is_trivially_copyable<DataType>::value> isTrivial;
+
+    // copy-constructs n data elements from src into the raw storage at dst
+    static void copyConstruct(const DataType *src, size_t n, DataType *dst, std::true_type)
+    {
+        if (n > 0)
+        {
+          std::memcpy(dst, src, n * sizeof(DataType));
+        }
+    }
+
+    static void copyConstruct(const DataType *src, size_t n, DataType *dst, std::false_type)
+    {
+        for (size_t k = 0; k < n; ++k)
+        {
+          new (dst + k) DataType(src[k]);
+        }
+    }
+
+    // move-constructs n data elements from src into the raw storage at dst; the originals stay alive
+    static void moveConstruct(DataType *src, size_t n, DataType *dst, std::true_type)
+    {
+        copyConstruct(src, n, dst, std::true_type());
+    }
+
+    static void moveConstruct(DataType *src, size_t n, DataType *dst, std::false_type)
+    {
+        for (size_t k = 0; k < n; ++k)
+        {
+          new (dst + k) DataType(std::move(src[k]));
+        }
+    }
+
+    // move-constructs n data elements from src into the raw storage at dst and destroys the originals
+    static void relocate(DataType *src, size_t n, DataType *dst, std::true_type)
+    {
+        copyConstruct(src, n, dst, std::true_type());
+    }
+
+    static void relocate(DataType *src, size_t n, DataType *dst, std::false_type)
+    {
+        for (size_t k = 0; k < n; ++k)
+        {
+          new (dst + k) DataType(std::move(src[k]));
+          src[k].~DataType();
+        }
+    }
+
+    // moves n data elements from src to dst inside the same storage; the ranges may overlap
+    // the slots left behind at src are raw afterwards
+    static void shift(DataType *src, size_t n, DataType *dst, std::true_type)
+    {
+        if (n > 0)
+        {
+          std::memmove(dst, src, n * sizeof(DataType));
+        }
+    }
+
+    static void shift(DataType *src, size_t n, DataType *dst, std::false_type)
+    {
+        if (dst == src)
+        {
+          return;
+        }
+        if (dst < src)
+        {
+          relocate(src, n, dst, std::false_type());
+        }
+        else
+        {
+          for (size_t k = n; k > 0; --k)
+          {
+            new (dst + k - 1) DataType(std::move(src[k - 1]));
+            src[k - 1].~DataType();
+          }
+        }
+    }
 
   public:
-    
+
     static const size_t SPARE_CAPACITY = 16;   // initial capacity of the vector
 
     // default constructor
-    explicit MyVector(size_t initSize = 0) : 
+    explicit MyVector(size_t initSize = 0, const Alloc & alloc = Alloc()) :
         theSize{initSize},
-        theCapacity{initSize + SPARE_CAPACITY}
+        theCapacity{initSize + SPARE_CAPACITY},
+        theAllocator(alloc)
     {
-        data = new DataType[theCapacity];
+        data = allocate(theCapacity);
+        for (size_t k = 0; k < theSize; ++k)
+        {
+          new (data + k) DataType();
+        }
     }
 
     // copy constructor
-    MyVector(const MyVector & rhs) : 
+    MyVector(const MyVector & rhs) :
         theSize{rhs.theSize},
-        theCapacity{rhs.theCapacity}
+        theCapacity{rhs.theCapacity},
+        theAllocator(rhs.theAllocator)
     {
-        data = new DataType[theCapacity];
-        for (int k = 0; k < theSize; ++k)
-        {
-          data[k] = rhs.data[k];
-        }
+        data = allocate(theCapacity);
+        copyConstruct(rhs.data, theSize, data, isTrivial());
     }
 
     // move constructor
     MyVector(MyVector&& rhs):
         theSize{rhs.theSize},
         theCapacity{rhs.theCapacity},
-        data{rhs.data}
+        data{rhs.data},
+        theAllocator(std::move(rhs.theAllocator)),
+        theGrowth(std::move(rhs.theGrowth))
     {
         rhs.data = nullptr;
         rhs.theSize = 0;
@@ -49,21 +307,20 @@ class MyVector
     }
 
     // copy constructor from STL vector implementation
-    MyVector(const std::vector<DataType> & rhs) :
+    MyVector(const std::vector<DataType> & rhs, const Alloc & alloc = Alloc()) :
         theSize{rhs.size()},
-        theCapacity{rhs.size() + SPARE_CAPACITY}
+        theCapacity{rhs.size() + SPARE_CAPACITY},
+        theAllocator(alloc)
     {
-        data = new DataType[theCapacity];
-        for (int k = 0; k < theSize; ++k)
-        {
-          data[k] = rhs[k];
-        }       
+        data = allocate(theCapacity);
+        copyConstruct(rhs.data(), theSize, data, isTrivial());
     }
 
     // destructor
     ~MyVector()
     {
-        delete [] data;
+        destroy(data, data + theSize);
+        deallocate(data, theCapacity);
     };
 
     // copy assignment
@@ -80,34 +337,47 @@ class MyVector
         std::swap(theSize, rhs.theSize);
         std::swap(theCapacity, rhs.theCapacity);
         std::swap(data, rhs.data);
+        std::swap(theAllocator, rhs.theAllocator);
+        std::swap(theGrowth, rhs.theGrowth);
         return *this;
     }
 
     // change the size of the array
+    // new data elements are value-initialized; dropped data elements are destroyed
     void resize(size_t newSize)
     {
         if (newSize > theCapacity)
         {
-          reserve(newSize * 2);
+          reserve(Growth::grow(theCapacity, newSize));
+        }
+        if (newSize < theSize)
+        {
+          destroy(data + newSize, data + theSize);
+        }
+        for (size_t k = theSize; k < newSize; ++k)
+        {
+          new (data + k) DataType();
         }
         theSize = newSize;
     }
 
     // allocate more memory for the array
+    // only the data elements currently held are moved; the spare slots stay unconstructed
     void reserve(size_t newCapacity)
     {
-        if (newCapacity < theSize)
+        if (newCapacity < theSize || newCapacity == theCapacity)
         {
           return;
-        }     
-        DataType *newArray = new DataType[newCapacity];
-        for (int k = 0; k < theSize; ++k)
-        {
-          newArray[k] = std::move(data[k]);
         }
-        theCapacity = newCapacity;
-        std::swap(data, newArray);
-        delete [] newArray;
+        DataType *newArray = allocate(newCapacity);
+        relocate(data, theSize, newArray, isTrivial());
+        adoptStorage(newArray, newCapacity);
+    }
+
+    // release the spare capacity so that the capacity matches the size
+    void shrink_to_fit()
+    {
+        reserve(theSize);
     }
 
     // data access operator (without bound checking)
@@ -121,61 +391,110 @@ class MyVector
         return data[index];
     }
 
-    // check if the vector is empty; return TURE if the vector is empty
+    // check if the vector is empty; return TRUE if the vector is empty
     bool empty() const
     {
         return size() == 0;
     }
 
+    // remove all data elements from the vector
+    // O(1) for trivially destructible data elements
+    void clear()
+    {
+        destroy(data, data + theSize);
+        theSize = 0;
+    }
+
     // returns the size of the vector
-    size_t size() const 
+    size_t size() const
     {
         return theSize;
     }
 
     // returns the capacity of the vector
-    size_t capacity() const 
+    size_t capacity() const
     {
         return theCapacity;
     }
 
-    // insert an data element to the end of the vector
-    void push_back(const DataType & x)
+    // returns the growth policy; MyTrackedGrowth exposes reallocations(), bytesCopied() and peakCapacity()
+    const Growth& growth() const
+    {
+        return theGrowth;
+    }
+
+    // construct a data element in place at the end of the vector
+    // when the vector grows, the new element is constructed before the old ones are moved,
+    // so the arguments may refer to an element of this vector
+    template <typename... Args>
+    void emplace_back(Args&&... args)
     {
         if (theSize == theCapacity)
         {
-          reserve(2 * theCapacity + 1);
+          size_t newCapacity = Growth::grow(theCapacity, theSize + 1);
+          DataType *newArray = allocate(newCapacity);
+          new (newArray + theSize) DataType(std::forward<Args>(args)...);
+          relocate(data, theSize, newArray, isTrivial());
+          adoptStorage(newArray, newCapacity);
         }
-        data[theSize++] = x;
+        else
+        {
+          new (data + theSize) DataType(std::forward<Args>(args)...);
+        }
+        ++theSize;
+    }
+
+    // insert an data element to the end of the vector
+    void push_back(const DataType & x)
+    {
+        emplace_back(x);
     }
 
     void push_back(DataType && x)
     {
-        if (theSize == theCapacity)
+        emplace_back(std::move(x));
+    }
+
+    // append a vector as indicated by the parameter to the current vector
+    MyVector& append(MyVector && rhs)
+    {
+        if (theSize + rhs.theSize > theCapacity)
         {
-          reserve(2 * theCapacity + 1);
+          reserve(Growth::grow(theCapacity, theSize + rhs.theSize));
         }
-        data[theSize++] = std::move(x);
+        moveConstruct(rhs.data, rhs.theSize, data + theSize, isTrivial());
+        theSize += rhs.theSize;
+        return *this;
     }
 
-    // append a vector as indicated by the parameter to the current vector
-    MyVector<DataType>& append(MyVector<DataType> && rhs)
+    // append n data elements starting at first to the current vector
+    // the range may point into this vector
+    MyVector& append(const DataType *first, size_t n)
     {
-        for (int k = 0; k < rhs.theSize; ++k)
+        if (theSize + n > theCapacity)
+        {
+          size_t newCapacity = Growth::grow(theCapacity, theSize + n);
+          DataType *newArray = allocate(newCapacity);
+          copyConstruct(first, n, newArray + theSize, isTrivial());
+          relocate(data, theSize, newArray, isTrivial());
+          adoptStorage(newArray, newCapacity);
+        }
+        else
         {
-          push_back(rhs.data[k]);
+          copyConstruct(first, n, data + theSize, isTrivial());
         }
+        theSize += n;
         return *this;
     }
 
     // remove the last data element from the array
     void pop_back()
     {
-        --theSize;
+        data[--theSize].~DataType();
     }
 
     // returns the last data elemtn from the array
-    const DataType& back() const 
+    const DataType& back() const
     {
         return data[theSize - 1];
     }
@@ -187,22 +506,72 @@ class MyVector
 
     iterator begin()
     {
-        return &data[0];
+        return data;
     }
 
     const_iterator begin() const
     {
-        return &data[0];
+        return data;
     }
 
     iterator end()
     {
-        return &data[size()];
+        return data + size();
+    }
+
+    const_iterator end() const
+    {
+        return data + size();
+    }
+
+    // insert copies of the data elements in [first, last) before pos
+    // returns the iterator pointing to the first inserted data element; the range may point into this vector
+    iterator insert(iterator pos, const DataType *first, const DataType *last)
+    {
+        size_t p = pos - data;
+        size_t n = last - first;
+        size_t tail = theSize - p;
+        if (theSize + n > theCapacity)
+        {
+          size_t newCapacity = Growth::grow(theCapacity, theSize + n);
+          DataType *newArray = allocate(newCapacity);
+          copyConstruct(first, n, newArray + p, isTrivial());
+          relocate(data, p, newArray, isTrivial());
+          relocate(data + p, tail, newArray + p + n, isTrivial());
+          adoptStorage(newArray, newCapacity);
+        }
+        else if (n > 0)
+        {
+          std::less<const DataType*> before;
+          if (!before(first, data) && before(first, data + theSize))
+          {
+            MyVector copy(0, theAllocator);
+            copy.append(first, n);
+            return insert(pos, copy.begin(), copy.end());
+          }
+          shift(data + p, tail, data + p + n, isTrivial());
+          copyConstruct(first, n, data + p, isTrivial());
+        }
+        theSize += n;
+        return data + p;
+    }
+
+    // delete the data elements in [first, last)
+    // returns the iterator pointing to the data element that followed the erased ones
+    iterator erase(iterator first, iterator last)
+    {
+        size_t p = first - data;
+        size_t n = last - first;
+        destroy(first, last);
+        shift(last, theSize - p - n, first, isTrivial());
+        theSize -= n;
+        return data + p;
     }
 
-    const_iterator end() const 
+    // delete the data element pointed by pos
+    iterator erase(iterator pos)
     {
-        return &data[size()];
+        return erase(pos, pos + 1);
     }
 
 };
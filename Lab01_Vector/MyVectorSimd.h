@@ -0,0 +1,454 @@
+#ifndef __MYVECTORSIMD_H__
+#define __MYVECTORSIMD_H__
+
+#include <cstddef>
+
+#include "MyVector.h"
+
+// search and reduction kernels over contiguous arrays of arithmetic data elements
+// int, long long and float use AVX2 when the CPU supports it (checked once at run time) and plain loops otherwise;
+// every other element type always uses the plain loops
+//
+//   simdFind(v, x)        index of the first element equal to x, or v.size() if there is none
+//   simdCount(v, x)       number of elements equal to x
+//   simdMinIndex(v)       index of the first smallest element, or v.size() if v is empty
+//   simdMaxIndex(v)       index of the first largest element, or v.size() if v is empty
+//   simdSum(v)            sum of the elements; int is summed as long long and float as double
+//   simdPrefixSum(v)      replaces every element with the sum of itself and all elements before it
+//
+// NaN ordering in simdMinIndex/simdMaxIndex is unspecified, though the index returned is always valid; float sums are
+// accumulated in double lanes and may differ from a sequential double sum in the last bits
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MY_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+// the type simdSum returns for each element type
+template <typename DataType>
+struct MySimdSumType
+{
+    typedef DataType type;
+};
+
+template <>
+struct MySimdSumType<int>
+{
+    typedef long long type;
+};
+
+template <>
+struct MySimdSumType<float>
+{
+    typedef double type;
+};
+
+// the plain loops; also used for the leftover tail of the vectorized kernels
+template <typename DataType>
+struct MyScalarKernels
+{
+    static size_t find(const DataType *a, size_t n, const DataType & x)
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+          if (a[i] == x)
+          {
+            return i;
+          }
+        }
+        return n;
+    }
+
+    static size_t count(const DataType *a, size_t n, const DataType & x)
+    {
+        size_t c = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+          c += (a[i] == x);
+        }
+        return c;
+    }
+
+    static size_t minIndex(const DataType *a, size_t n)
+    {
+        size_t best = 0;
+        for (size_t i = 1; i < n; ++i)
+        {
+          if (a[i] < a[best])
+          {
+            best = i;
+          }
+        }
+        return (n == 0) ? 0 : best;
+    }
+
+    static size_t maxIndex(const DataType *a, size_t n)
+    {
+        size_t best = 0;
+        for (size_t i = 1; i < n; ++i)
+        {
+          if (a[best] < a[i])
+          {
+            best = i;
+          }
+        }
+        return (n == 0) ? 0 : best;
+    }
+
+    static typename MySimdSumType<DataType>::type sum(const DataType *a, size_t n)
+    {
+        typename MySimdSumType<DataType>::type s = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+          s += a[i];
+        }
+        return s;
+    }
+
+    static void prefixSum(DataType *a, size_t n)
+    {
+        for (size_t i = 1; i < n; ++i)
+        {
+          a[i] += a[i - 1];
+        }
+    }
+};
+
+// the kernels simd*() dispatch to; specialized below for the element types that have AVX2 versions
+template <typename DataType>
+struct MySimdKernels : public MyScalarKernels<DataType>
+{
+
+};
+
+#ifdef MY_SIMD_X86
+
+// checks once whether the running CPU supports AVX2
+inline bool simdHasAvx2()
+{
+    static const bool avx2 = __builtin_cpu_supports("avx2");
+    return avx2;
+}
+
+// per-type AVX2 building blocks for the shared find/count/min/max kernels
+
+struct MyAvx2Int
+{
+    typedef int value_type;
+    typedef __m256i reg;
+    static const size_t lanes = 8;
+
+    __attribute__((target("avx2"))) static reg load(const int *p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    __attribute__((target("avx2"))) static reg set1(int x) { return _mm256_set1_epi32(x); }
+    __attribute__((target("avx2"))) static int eqMask(reg a, reg b) { return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b))); }
+    __attribute__((target("avx2"))) static reg min(reg a, reg b) { return _mm256_min_epi32(a, b); }
+    __attribute__((target("avx2"))) static reg max(reg a, reg b) { return _mm256_max_epi32(a, b); }
+    __attribute__((target("avx2"))) static void store(int *p, reg a) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), a); }
+};
+
+struct MyAvx2LongLong
+{
+    typedef long long value_type;
+    typedef __m256i reg;
+    static const size_t lanes = 4;
+
+    __attribute__((target("avx2"))) static reg load(const long long *p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    __attribute__((target("avx2"))) static reg set1(long long x) { return _mm256_set1_epi64x(x); }
+    __attribute__((target("avx2"))) static int eqMask(reg a, reg b) { return _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(a, b))); }
+    __attribute__((target("avx2"))) static reg min(reg a, reg b) { return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b)); }
+    __attribute__((target("avx2"))) static reg max(reg a, reg b) { return _mm256_blendv_epi8(b, a, _mm256_cmpgt_epi64(a, b)); }
+    __attribute__((target("avx2"))) static void store(long long *p, reg a) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), a); }
+};
+
+struct MyAvx2Float
+{
+    typedef float value_type;
+    typedef __m256 reg;
+    static const size_t lanes = 8;
+
+    __attribute__((target("avx2"))) static reg load(const float *p) { return _mm256_loadu_ps(p); }
+    __attribute__((target("avx2"))) static reg set1(float x) { return _mm256_set1_ps(x); }
+    __attribute__((target("avx2"))) static int eqMask(reg a, reg b) { return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ)); }
+    __attribute__((target("avx2"))) static reg min(reg a, reg b) { return _mm256_min_ps(a, b); }
+    __attribute__((target("avx2"))) static reg max(reg a, reg b) { return _mm256_max_ps(a, b); }
+    __attribute__((target("avx2"))) static void store(float *p, reg a) { _mm256_storeu_ps(p, a); }
+};
+
+// the find/count/min/max kernels shared by all AVX2 element types
+template <typename Ops>
+struct MyAvx2Kernels
+{
+    typedef typename Ops::value_type T;
+    typedef typename Ops::reg reg;
+
+    __attribute__((target("avx2")))
+    static size_t find(const T *a, size_t n, const T & x)
+    {
+        reg key = Ops::set1(x);
+        size_t i = 0;
+        for (; i + Ops::lanes <= n; i += Ops::lanes)
+        {
+          int mask = Ops::eqMask(Ops::load(a + i), key);
+          if (mask != 0)
+          {
+            return i + __builtin_ctz(mask);
+          }
+        }
+        return i + MyScalarKernels<T>::find(a + i, n - i, x);
+    }
+
+    __attribute__((target("avx2")))
+    static size_t count(const T *a, size_t n, const T & x)
+    {
+        reg key = Ops::set1(x);
+        size_t c = 0;
+        size_t i = 0;
+        for (; i + Ops::lanes <= n; i += Ops::lanes)
+        {
+          c += __builtin_popcount(Ops::eqMask(Ops::load(a + i), key));
+        }
+        return c + MyScalarKernels<T>::count(a + i, n - i, x);
+    }
+
+    // finds the smallest (Largest == false) or largest value, then the first position holding it
+    template <bool Largest>
+    __attribute__((target("avx2")))
+    static size_t extremeIndex(const T *a, size_t n)
+    {
+        if (n < Ops::lanes)
+        {
+          return Largest ? MyScalarKernels<T>::maxIndex(a, n) : MyScalarKernels<T>::minIndex(a, n);
+        }
+        reg best = Ops::load(a);
+        size_t i = Ops::lanes;
+        for (; i + Ops::lanes <= n; i += Ops::lanes)
+        {
+          best = Largest ? Ops::max(best, Ops::load(a + i)) : Ops::min(best, Ops::load(a + i));
+        }
+        T lanes[Ops::lanes];
+        Ops::store(lanes, best);
+        T value = lanes[0];
+        for (size_t k = 1; k < Ops::lanes; ++k)
+        {
+          value = (Largest ? (value < lanes[k]) : (lanes[k] < value)) ? lanes[k] : value;
+        }
+        for (; i < n; ++i)
+        {
+          value = (Largest ? (value < a[i]) : (a[i] < value)) ? a[i] : value;
+        }
+        size_t index = find(a, n, value);
+        if (index == n)
+        {
+          // a NaN compares equal to nothing, so a NaN value (or one picked past a NaN) can have no position; the scalar
+          // scan always returns a valid one
+          return Largest ? MyScalarKernels<T>::maxIndex(a, n) : MyScalarKernels<T>::minIndex(a, n);
+        }
+        return index;
+    }
+
+    static size_t minIndex(const T *a, size_t n)
+    {
+        return extremeIndex<false>(a, n);
+    }
+
+    static size_t maxIndex(const T *a, size_t n)
+    {
+        return extremeIndex<true>(a, n);
+    }
+};
+
+__attribute__((target("avx2")))
+inline long long avx2Sum(const int *a, size_t n)
+{
+    __m256i lo = _mm256_setzero_si256();
+    __m256i hi = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+      __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+      lo = _mm256_add_epi64(lo, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+      hi = _mm256_add_epi64(hi, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+    }
+    long long lanes[4];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), _mm256_add_epi64(lo, hi));
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + MyScalarKernels<int>::sum(a + i, n - i);
+}
+
+__attribute__((target("avx2")))
+inline long long avx2Sum(const long long *a, size_t n)
+{
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+      acc = _mm256_add_epi64(acc, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)));
+    }
+    long long lanes[4];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + MyScalarKernels<long long>::sum(a + i, n - i);
+}
+
+__attribute__((target("avx2")))
+inline double avx2Sum(const float *a, size_t n)
+{
+    __m256d lo = _mm256_setzero_pd();
+    __m256d hi = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+      __m256 v = _mm256_loadu_ps(a + i);
+      lo = _mm256_add_pd(lo, _mm256_cvtps_pd(_mm256_castps256_ps128(v)));
+      hi = _mm256_add_pd(hi, _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1)));
+    }
+    double lanes[4];
+    _mm256_storeu_pd(lanes, _mm256_add_pd(lo, hi));
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + MyScalarKernels<float>::sum(a + i, n - i);
+}
+
+// in-register scan of 8 ints: two shifted adds per 128-bit half, then the low half's total is carried into the high half
+__attribute__((target("avx2")))
+inline void avx2PrefixSum(int *a, size_t n)
+{
+    __m256i carry = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+      __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+      x = _mm256_add_epi32(x, _mm256_slli_si256(x, 4));
+      x = _mm256_add_epi32(x, _mm256_slli_si256(x, 8));
+      __m256i lowTotal = _mm256_shuffle_epi32(x, _MM_SHUFFLE(3, 3, 3, 3));
+      x = _mm256_add_epi32(x, _mm256_permute2x128_si256(lowTotal, lowTotal, 0x08));
+      x = _mm256_add_epi32(x, carry);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(a + i), x);
+      carry = _mm256_permutevar8x32_epi32(x, _mm256_set1_epi32(7));
+    }
+    for (; i < n; ++i)
+    {
+      a[i] += (i == 0) ? 0 : a[i - 1];
+    }
+}
+
+// the same scan for 4 long longs per register
+__attribute__((target("avx2")))
+inline void avx2PrefixSum(long long *a, size_t n)
+{
+    __m256i carry = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+      __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+      x = _mm256_add_epi64(x, _mm256_slli_si256(x, 8));
+      __m256i lowTotal = _mm256_permute4x64_epi64(x, _MM_SHUFFLE(1, 1, 0, 0));
+      x = _mm256_add_epi64(x, _mm256_blend_epi32(_mm256_setzero_si256(), lowTotal, 0xF0));
+      x = _mm256_add_epi64(x, carry);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(a + i), x);
+      carry = _mm256_permute4x64_epi64(x, _MM_SHUFFLE(3, 3, 3, 3));
+    }
+    for (; i < n; ++i)
+    {
+      a[i] += (i == 0) ? 0 : a[i - 1];
+    }
+}
+
+// picks the AVX2 kernels when the CPU has them; Ops is the matching building-block struct above
+template <typename Ops>
+struct MyDispatchedKernels
+{
+    typedef typename Ops::value_type T;
+
+    static size_t find(const T *a, size_t n, const T & x)
+    {
+        return simdHasAvx2() ? MyAvx2Kernels<Ops>::find(a, n, x) : MyScalarKernels<T>::find(a, n, x);
+    }
+
+    static size_t count(const T *a, size_t n, const T & x)
+    {
+        return simdHasAvx2() ? MyAvx2Kernels<Ops>::count(a, n, x) : MyScalarKernels<T>::count(a, n, x);
+    }
+
+    static size_t minIndex(const T *a, size_t n)
+    {
+        return simdHasAvx2() ? MyAvx2Kernels<Ops>::minIndex(a, n) : MyScalarKernels<T>::minIndex(a, n);
+    }
+
+    static size_t maxIndex(const T *a, size_t n)
+    {
+        return simdHasAvx2() ? MyAvx2Kernels<Ops>::maxIndex(a, n) : MyScalarKernels<T>::maxIndex(a, n);
+    }
+
+    static typename MySimdSumType<T>::type sum(const T *a, size_t n)
+    {
+        return simdHasAvx2() ? avx2Sum(a, n) : MyScalarKernels<T>::sum(a, n);
+    }
+};
+
+template <>
+struct MySimdKernels<int> : public MyDispatchedKernels<MyAvx2Int>
+{
+    static void prefixSum(int *a, size_t n)
+    {
+        simdHasAvx2() ? avx2PrefixSum(a, n) : MyScalarKernels<int>::prefixSum(a, n);
+    }
+};
+
+template <>
+struct MySimdKernels<long long> : public MyDispatchedKernels<MyAvx2LongLong>
+{
+    static void prefixSum(long long *a, size_t n)
+    {
+        simdHasAvx2() ? avx2PrefixSum(a, n) : MyScalarKernels<long long>::prefixSum(a, n);
+    }
+};
+
+// a vectorized float scan would reassociate the additions, so float keeps the sequential scan
+template <>
+struct MySimdKernels<float> : public MyDispatchedKernels<MyAvx2Float>
+{
+    static void prefixSum(float *a, size_t n)
+    {
+        MyScalarKernels<float>::prefixSum(a, n);
+    }
+};
+
+#endif // MY_SIMD_X86
+
+// the MyVector front ends
+
+template <typename DataType, typename Alloc, typename Growth>
+size_t simdFind(const MyVector<DataType, Alloc, Growth> & v, const DataType & x)
+{
+    return MySimdKernels<DataType>::find(v.begin(), v.size(), x);
+}
+
+template <typename DataType, typename Alloc, typename Growth>
+size_t simdCount(const MyVector<DataType, Alloc, Growth> & v, const DataType & x)
+{
+    return MySimdKernels<DataType>::count(v.begin(), v.size(), x);
+}
+
+template <typename DataType, typename Alloc, typename Growth>
+size_t simdMinIndex(const MyVector<DataType, Alloc, Growth> & v)
+{
+    return v.empty() ? v.size() : MySimdKernels<DataType>::minIndex(v.begin(), v.size());
+}
+
+template <typename DataType, typename Alloc, typename Growth>
+size_t simdMaxIndex(const MyVector<DataType, Alloc, Growth> & v)
+{
+    return v.empty() ? v.size() : MySimdKernels<DataType>::maxIndex(v.begin(), v.size());
+}
+
+template <typename DataType, typename Alloc, typename Growth>
+typename MySimdSumType<DataType>::type simdSum(const MyVector<DataType, Alloc, Growth> & v)
+{
+    return MySimdKernels<DataType>::sum(v.begin(), v.size());
+}
+
+template <typename DataType, typename Alloc, typename Growth>
+void simdPrefixSum(MyVector<DataType, Alloc, Growth> & v)
+{
+    MySimdKernels<DataType>::prefixSum(v.begin(), v.size());
+}
+
+
+#endif // __MYVECTORSIMD_H__
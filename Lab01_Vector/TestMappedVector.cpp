@@ -0,0 +1,129 @@
+// round trip of MyMappedVector: store() a MyVector<int>, open the file in both modes and compare, check that a
+// MAPPED_COPY_ON_WRITE write never reaches the file, and check that open() rejects a file stored with another element
+// size, a truncated file and a file that is not a MyMappedVector file
+// usage: ./TestMappedVector [elements] [file]   (default 100000 TestMappedVector.bin); exits with 1 if a check fails
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <type_traits>
+
+#include <unistd.h>
+
+#include "MyMappedVector.h"
+#include "MyVector.h"
+
+using namespace std;
+
+// a read-only mapping must not hand out anything that can be written through
+static_assert(is_same<decltype(declval<MyMappedVector<int>&>()[0]), const int&>::value,
+              "MAPPED_READ_ONLY operator[] must return a const reference");
+static_assert(is_same<MyMappedVector<int>::iterator, const int*>::value,
+              "MAPPED_READ_ONLY iterators must be const");
+static_assert(is_same<decltype(declval<MyMappedVector<int, MAPPED_COPY_ON_WRITE>&>()[0]), int&>::value,
+              "MAPPED_COPY_ON_WRITE operator[] must return a reference");
+
+static bool failed = false;
+
+static void check(bool ok, const char *what)
+{
+    printf("%-60s %s\n", what, ok ? "ok" : "FAILED");
+    failed = failed || !ok;
+}
+
+// checks that mapped holds exactly the elements of vec
+template <typename Mapped>
+bool sameElements(const Mapped & mapped, const MyVector<int> & vec)
+{
+    if (!mapped.isOpen() || mapped.size() != vec.size())
+    {
+      return false;
+    }
+    size_t k = 0;
+    for (typename Mapped::const_iterator itr = mapped.begin(); itr != mapped.end(); ++itr, ++k)
+    {
+      if (*itr != vec[k])
+      {
+        return false;
+      }
+    }
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    // at least one element, so there is something to write and something to cut off
+    size_t n = (argc > 1) ? max(strtoul(argv[1], nullptr, 10), 1ul) : 100000;
+    string fileName = (argc > 2) ? argv[2] : "TestMappedVector.bin";
+
+    MyVector<int> vec;
+    for (size_t k = 0; k < n; ++k)
+    {
+      vec.push_back(static_cast<int>(k * 2654435761u));
+    }
+    check(MyMappedVector<int>::store(fileName, vec), "store()");
+
+    {
+      MyMappedVector<int> readOnly;
+      check(readOnly.open(fileName) && sameElements(readOnly, vec), "MAPPED_READ_ONLY open() matches what was stored");
+    }
+    {
+      MyMappedVector<int, MAPPED_COPY_ON_WRITE> copyOnWrite;
+      bool ok = copyOnWrite.open(fileName) && sameElements(copyOnWrite, vec);
+      check(ok, "MAPPED_COPY_ON_WRITE open() matches what was stored");
+      if (ok)
+      {
+        copyOnWrite[0] = ~vec[0];
+        check(copyOnWrite[0] == ~vec[0], "MAPPED_COPY_ON_WRITE write is visible in the mapping");
+      }
+    }
+    {
+      MyMappedVector<int> reopened;
+      check(reopened.open(fileName) && sameElements(reopened, vec), "the write did not reach the file");
+    }
+    {
+      MyMappedVector<int> empty;
+      check(MyMappedVector<int>::store(fileName, vec.begin(), 0) && empty.open(fileName) && empty.empty(),
+            "an empty vector round-trips");
+    }
+
+    MyVector<short> shorts;
+    for (size_t k = 0; k < 64; ++k)
+    {
+      shorts.push_back(static_cast<short>(k));
+    }
+    MyMappedVector<short>::store(fileName, shorts);
+    {
+      MyMappedVector<int> wrongSize;
+      check(!wrongSize.open(fileName) && !wrongSize.isOpen(), "open() rejects a file stored with another element size");
+    }
+
+    // keeps the header (64 bytes) and the count, but drops the last data element
+    MyMappedVector<int>::store(fileName, vec);
+    check(truncate(fileName.c_str(), 64 + (n - 1) * sizeof(int)) == 0, "truncate()");
+    {
+      MyMappedVector<int> truncated;
+      check(!truncated.open(fileName) && !truncated.isOpen(), "open() rejects a truncated file");
+    }
+    {
+      truncate(fileName.c_str(), 32);
+      MyMappedVector<int> noHeader;
+      check(!noHeader.open(fileName), "open() rejects a file shorter than the header");
+    }
+    {
+      ofstream outFile(fileName.c_str(), ios::binary | ios::trunc);
+      string text(256, 'x');
+      outFile.write(text.data(), text.size());
+      outFile.close();
+      MyMappedVector<int> foreign;
+      check(!foreign.open(fileName), "open() rejects a file without the magic string");
+    }
+    {
+      MyMappedVector<int> missing;
+      unlink(fileName.c_str());
+      check(!missing.open(fileName), "open() rejects a missing file");
+    }
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,171 @@
+// list churn on MyLinkedList (nodes from MyNodePool) against std::list (a new and a delete per node, as MyLinkedList
+// did before the pool), counting the calls to the global operator new; then short-lived threads that each build and
+// drop a list, checking that the peak memory stays flat because every thread hands its pool back when it exits; then a
+// producer thread that builds lists and a consumer thread that destroys them, checking that the peak memory stays flat
+// because the consumer's pool spills the slots it frees back to the producer
+// usage: ./BenchNodePool [cycles] [threads] [handoffs]   (default 10000000 400 1000)
+// build with -pthread
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+#include <mutex>
+#include <new>
+#include <thread>
+
+#include <sys/resource.h>
+
+#include "MyLinkedList.h"
+
+using namespace std;
+
+static size_t heapAllocations = 0;
+
+void* operator new(size_t bytes)
+{
+    ++heapAllocations;
+    void *p = malloc(bytes ? bytes : 1);
+    if (p == nullptr)
+    {
+      throw bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void *p) noexcept
+{
+    free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+    free(p);
+}
+
+// push_back, front and pop_front every cycle, plus a push_front and a pop_back every third cycle, on 64 elements
+template <typename List>
+long long churn(size_t cycles)
+{
+    List l;
+    for (int k = 0; k < 64; ++k)
+    {
+      l.push_back(k);
+    }
+    long long sum = 0;
+    for (size_t k = 0; k < cycles; ++k)
+    {
+      l.push_back(static_cast<int>(k));
+      sum += l.front();
+      l.pop_front();
+      if (k % 3 == 0)
+      {
+        l.push_front(static_cast<int>(k));
+        l.pop_back();
+      }
+    }
+    return sum;
+}
+
+template <typename List>
+void timeChurn(const char *name, size_t cycles)
+{
+    for (int run = 0; run < 3; ++run)
+    {
+      size_t before = heapAllocations;
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      long long sum = churn<List>(cycles);
+      double millis = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+      printf("%-12s %7.1f ms, %zu operator new calls (checksum %lld)\n", name, millis, heapAllocations - before, sum);
+    }
+}
+
+// returns the peak resident set size in MB
+static double peakMegabytes()
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss / 1024.0;
+}
+
+// the producer builds a list of 10000 nodes, hands it over through one slot and builds the next; the consumer takes
+// each list out of the slot and destroys it, so every node is allocated by one thread and deallocated by the other
+static void handOff(size_t handoffs)
+{
+    MyLinkedList<int> slot;
+    bool full = false;
+    mutex lock;
+    condition_variable changed;
+    thread consumer([&slot, &full, &lock, &changed, handoffs]()
+        {
+            for (size_t k = 0; k < handoffs; ++k)
+            {
+              MyLinkedList<int> mine;
+              {
+                unique_lock<mutex> guard(lock);
+                changed.wait(guard, [&full]() { return full; });
+                mine = std::move(slot);
+                full = false;
+              }
+              changed.notify_one();
+            }
+        });
+    for (size_t k = 0; k < handoffs; ++k)
+    {
+      MyLinkedList<int> l;
+      for (int i = 0; i < 10000; ++i)
+      {
+        l.push_back(i);
+      }
+      {
+        unique_lock<mutex> guard(lock);
+        changed.wait(guard, [&full]() { return !full; });
+        slot = std::move(l);
+        full = true;
+      }
+      changed.notify_one();
+      if ((k + 1) % (handoffs / 4 ? handoffs / 4 : 1) == 0)
+      {
+        printf("after %5zu lists: peak RSS %6.1f MB\n", k + 1, peakMegabytes());
+      }
+    }
+    consumer.join();
+}
+
+int main(int argc, char* argv[])
+{
+    size_t cycles = (argc > 1) ? strtoul(argv[1], nullptr, 10) : 10000000;
+    size_t threads = (argc > 2) ? strtoul(argv[2], nullptr, 10) : 400;
+    size_t handoffs = (argc > 3) ? strtoul(argv[3], nullptr, 10) : 1000;
+
+    printf("%zu churn cycles on a 64-element list of int, 3 runs each\n", cycles);
+    timeChurn<list<int> >("std::list", cycles);
+    timeChurn<MyLinkedList<int> >("MyLinkedList", cycles);
+
+    // one thread at a time, each with 100000 nodes (about 4 MB of slabs); without the hand-back the slabs of every
+    // finished thread would stay allocated and the peak would grow with the number of threads
+    printf("%zu short-lived threads, 100000 nodes each\n", threads);
+    for (size_t k = 0; k < threads; ++k)
+    {
+      thread t([]()
+          {
+              MyLinkedList<int> l;
+              for (int i = 0; i < 100000; ++i)
+              {
+                l.push_back(i);
+              }
+          });
+      t.join();
+      if ((k + 1) % (threads / 4 ? threads / 4 : 1) == 0)
+      {
+        printf("after %4zu threads: peak RSS %6.1f MB\n", k + 1, peakMegabytes());
+      }
+    }
+
+    // without the spill the consumer's free list would keep every node (about 240 KB per list) and the producer would
+    // keep taking new slabs, so the peak would grow with the number of lists
+    printf("%zu lists of 10000 nodes built by one thread and destroyed by another\n", handoffs);
+    handOff(handoffs);
+    return 0;
+}
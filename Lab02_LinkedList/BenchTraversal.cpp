@@ -0,0 +1,105 @@
+// the time of one full scan of a list of ints: MyLinkedList built fresh (nodes in slab order) and after churn (nodes
+// handed back in random order, so consecutive elements land far apart), std::list after the same churn, and
+// MyUnrolledList with 16 and 64 elements per node
+// usage: ./BenchTraversal [elements]   (default 1000000)
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <list>
+#include <random>
+#include <vector>
+
+#include "MyLinkedList.h"
+#include "MyUnrolledList.h"
+
+using namespace std;
+
+// keeps the sums observable so the scans are not optimized away
+static volatile long long sink;
+
+// returns the best time (in milliseconds) of five full scans of l
+template <typename List>
+double scanMillis(List & l)
+{
+    double best = numeric_limits<double>::max();
+    for (int run = 0; run < 5; ++run)
+    {
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      long long sum = 0;
+      for (typename List::iterator itr = l.begin(); itr != l.end(); ++itr)
+      {
+        sum += *itr;
+      }
+      sink = sum;
+      best = min(best, chrono::duration<double, milli>(chrono::steady_clock::now() - start).count());
+    }
+    return best;
+}
+
+template <typename List>
+void fill(List & l, size_t n)
+{
+    for (size_t k = 0; k < n; ++k)
+    {
+      l.push_back(static_cast<int>(k));
+    }
+}
+
+// builds n elements, erases them all in random order and builds n again, so the nodes are reused in that order
+template <typename List>
+void churn(List & l, size_t n, mt19937 & rng)
+{
+    fill(l, n);
+    vector<typename List::iterator> nodes;
+    for (typename List::iterator itr = l.begin(); itr != l.end(); ++itr)
+    {
+      nodes.push_back(itr);
+    }
+    shuffle(nodes.begin(), nodes.end(), rng);
+    for (size_t k = 0; k < nodes.size(); ++k)
+    {
+      l.erase(nodes[k]);
+    }
+    fill(l, n);
+}
+
+int main(int argc, char* argv[])
+{
+    size_t n = (argc > 1) ? strtoul(argv[1], nullptr, 10) : 1000000;
+    mt19937 rng(560);
+    printf("%zu ints, ms per full scan, best of 5\n", n);
+
+    {
+      MyLinkedList<int> l;
+      churn(l, n, rng);
+      printf("%-46s %7.1f\n", "MyLinkedList, nodes recycled in random order", scanMillis(l));
+    }
+    {
+      list<int> l;
+      churn(l, n, rng);
+      printf("%-46s %7.1f\n", "std::list, same churn", scanMillis(l));
+    }
+    {
+      // the churned MyLinkedList gave its nodes back to the pool in random order; recycled soaks them up, so l is
+      // built from fresh slabs
+      MyLinkedList<int> recycled;
+      fill(recycled, n);
+      MyLinkedList<int> l;
+      fill(l, n);
+      printf("%-46s %7.1f\n", "MyLinkedList, freshly built (sequential slab)", scanMillis(l));
+    }
+    {
+      MyUnrolledList<int, 16> l;
+      fill(l, n);
+      printf("%-46s %7.1f\n", "MyUnrolledList<int,16>", scanMillis(l));
+    }
+    {
+      MyUnrolledList<int, 64> l;
+      fill(l, n);
+      printf("%-46s %7.1f\n", "MyUnrolledList<int,64>", scanMillis(l));
+    }
+    return 0;
+}
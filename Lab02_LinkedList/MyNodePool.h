@@ -0,0 +1,373 @@
+#ifndef __MYNODEPOOL_H__
+#define __MYNODEPOOL_H__
+
+#include <cstddef>
+#include <mutex>
+#include <new>
+
+#if defined(__GNUC__)
+#define MY_POOL_NOINLINE __attribute__((noinline))
+#else
+#define MY_POOL_NOINLINE
+#endif
+
+// a free-list pool handing out uninitialized storage for one NodeType at a time
+// storage comes from slabs of increasing size; freed slots go onto a free list and are reused before the slab is touched
+// each thread has its own pool (see local()), and a slot may be given back to any pool of the same NodeType,
+// so nodes can move freely between containers; slabs are kept for reuse until the program exits
+// when a thread exits, its pool hands its free slots to a shared store of orphaned slots, and the pool of a thread that
+// runs dry takes them over before asking the system for a new slab, so threads started one after another reuse the
+// same memory instead of each growing slabs of their own
+// a pool whose free list grows past spillSlots() hands the older part of it to the orphans as well, so slots freed by
+// a thread that does not allocate (e.g. the consumer of nodes built by another thread) flow back to the threads that do
+template <typename NodeType>
+class MyNodePool
+{
+    static_assert(sizeof(NodeType) >= sizeof(void*), "a free slot must be able to hold the free-list link");
+
+  private:
+    struct FreeSlot
+    {
+        FreeSlot *next;     // the next free slot
+    };
+
+    // the first slot of every slab links to the previous slab, so the slabs stay reachable
+    struct SlabHeader
+    {
+        SlabHeader *next;   // the previously allocated slab
+    };
+
+    // the free slots and slabs left behind by the pools of exited threads; slabs are never freed, since nodes still
+    // in use may live in them, but stay reachable from here
+    struct Orphans
+    {
+        std::mutex lock;
+        FreeSlot *freeList;
+        FreeSlot *freeTail;     // the last slot of freeList, so it can be spliced in front of a pool's list
+        size_t numFree;
+        SlabHeader *slabList;
+
+        Orphans() :
+            freeList{nullptr},
+            freeTail{nullptr},
+            numFree{0},
+            slabList{nullptr}
+        {
+
+        }
+    };
+
+    // hands the pool of the calling thread to the orphans when the thread exits
+    struct ThreadExit
+    {
+        ~ThreadExit()
+        {
+            local().release();
+        }
+    };
+
+    FreeSlot *freeList;     // slots given back by deallocate()
+    char *unused;           // the first never-used slot in the newest slab
+    char *unusedEnd;        // one past the last slot of the newest slab
+    SlabHeader *slabList;   // the newest slab
+    size_t slabSlots;       // the number of node slots in the next slab
+    size_t numSlabs;        // the number of slabs obtained from the system
+    size_t numLive;         // the number of slots currently handed out
+    size_t numFree;         // the number of slots on the free list
+    FreeSlot *freeTail;     // the last slot of freeList; only meaningful while freeList is not empty
+    SlabHeader *slabTail;   // the oldest slab; only meaningful while slabList is not empty
+
+    // the first slab holds this many node slots, and every later slab doubles it up to maxSlabSlots()
+    static constexpr size_t minSlabSlots()
+    {
+        return 8;
+    }
+
+    static constexpr size_t maxSlabSlots()
+    {
+        return 4096;
+    }
+
+    // a free list longer than spillSlots() keeps its newest spillKeepSlots() slots and hands the rest to the orphans
+    static constexpr size_t spillSlots()
+    {
+        return 2 * maxSlabSlots();
+    }
+
+    static constexpr size_t spillKeepSlots()
+    {
+        return maxSlabSlots();
+    }
+
+    // allocated once and never destroyed, so pools of threads exiting during program shutdown can still use it
+    static Orphans& orphans()
+    {
+        static Orphans *orphanage = new Orphans;
+        return *orphanage;
+    }
+
+    // makes sure the pool of the calling thread is handed to the orphans when the thread exits; called whenever the
+    // pool takes memory from the system or the orphans, so threads that never allocate pay nothing
+    static void releaseAtThreadExit()
+    {
+        static thread_local ThreadExit atExit;
+        (void)atExit;
+    }
+
+    // puts slot at the front of the free list
+    void pushFree(FreeSlot *slot)
+    {
+        if (freeList == nullptr)
+        {
+          freeTail = slot;
+        }
+        slot->next = freeList;
+        freeList = slot;
+        ++numFree;
+    }
+
+    // moves the never-used slots of the newest slab onto the free list
+    void freeUnused()
+    {
+        for ( ; unused != unusedEnd; unused += sizeof(NodeType))
+        {
+          pushFree(reinterpret_cast<FreeSlot*>(unused));
+        }
+    }
+
+    // puts a slab of slots + 1 node slots (the first holding the header) at the front of the slab list; returns the
+    // first node slot
+    char* pushSlab(size_t slots)
+    {
+        releaseAtThreadExit();
+        char *slab = static_cast<char*>(::operator new((slots + 1) * sizeof(NodeType)));
+        SlabHeader *header = reinterpret_cast<SlabHeader*>(slab);
+        if (slabList == nullptr)
+        {
+          slabTail = header;
+        }
+        header->next = slabList;
+        slabList = header;
+        ++numSlabs;
+        return slab + sizeof(NodeType);
+    }
+
+    // hands the n free slots first .. last (already linked to each other) to the orphans
+    static void orphanSlots(FreeSlot *first, FreeSlot *last, size_t n)
+    {
+        Orphans & o = orphans();
+        std::lock_guard<std::mutex> guard(o.lock);
+        if (o.freeList == nullptr)
+        {
+          o.freeTail = last;
+        }
+        last->next = o.freeList;
+        o.freeList = first;
+        o.numFree += n;
+    }
+
+    // takes over the free slots of the orphans; returns false if there were none
+    bool adoptOrphans()
+    {
+        FreeSlot *first;
+        FreeSlot *last;
+        size_t n;
+        {
+          Orphans & o = orphans();
+          std::lock_guard<std::mutex> guard(o.lock);
+          if (o.freeList == nullptr)
+          {
+            return false;
+          }
+          first = o.freeList;
+          last = o.freeTail;
+          n = o.numFree;
+          o.freeList = nullptr;
+          o.freeTail = nullptr;
+          o.numFree = 0;
+        }
+        // the orphaned list goes in front, so the slots of this pool's own list stay in the order they were freed
+        if (freeList == nullptr)
+        {
+          freeTail = last;
+        }
+        last->next = freeList;
+        freeList = first;
+        numFree += n;
+        releaseAtThreadExit();
+        return true;
+    }
+
+    // hands all but the newest spillKeepSlots() free slots to the orphans; kept out of line like refill()
+    MY_POOL_NOINLINE void spill()
+    {
+        FreeSlot *lastKept = freeList;
+        for (size_t k = 1; k < spillKeepSlots(); ++k)
+        {
+          lastKept = lastKept->next;
+        }
+        FreeSlot *first = lastKept->next;
+        orphanSlots(first, freeTail, numFree - spillKeepSlots());
+        lastKept->next = nullptr;
+        freeTail = lastKept;
+        numFree = spillKeepSlots();
+    }
+
+    // hands every free slot and slab of this pool to the orphans, leaving the pool empty
+    void release()
+    {
+        freeUnused();
+        if (freeList != nullptr)
+        {
+          orphanSlots(freeList, freeTail, numFree);
+        }
+        if (slabList != nullptr)
+        {
+          Orphans & o = orphans();
+          std::lock_guard<std::mutex> guard(o.lock);
+          slabTail->next = o.slabList;
+          o.slabList = slabList;
+        }
+        freeList = nullptr;
+        freeTail = nullptr;
+        numFree = 0;
+        slabList = nullptr;
+        slabTail = nullptr;
+        unused = nullptr;
+        unusedEnd = nullptr;
+    }
+
+    // gives an empty pool more slots, from the orphans if they have any and from a new slab otherwise; kept out of
+    // line, since inlining the locking into allocate() slows down every allocation, not just the rare refill
+    MY_POOL_NOINLINE void refill()
+    {
+        if (!adoptOrphans())
+        {
+          newSlab();
+        }
+    }
+
+    void newSlab()
+    {
+        unused = pushSlab(slabSlots);
+        unusedEnd = unused + slabSlots * sizeof(NodeType);
+        if (slabSlots < maxSlabSlots())
+        {
+          slabSlots *= 2;
+        }
+    }
+
+  public:
+
+    constexpr MyNodePool() :
+        freeList{nullptr},
+        unused{nullptr},
+        unusedEnd{nullptr},
+        slabList{nullptr},
+        slabSlots{minSlabSlots()},
+        numSlabs{0},
+        numLive{0},
+        numFree{0},
+        freeTail{nullptr},
+        slabTail{nullptr}
+    {
+
+    }
+
+    MyNodePool(const MyNodePool & rhs) = delete;
+    MyNodePool & operator= (const MyNodePool & rhs) = delete;
+
+    // the pool of the calling thread
+    static MyNodePool& local()
+    {
+        static thread_local MyNodePool pool;
+        return pool;
+    }
+
+    // returns storage for one NodeType; the caller constructs the node in it
+    void* allocate()
+    {
+        ++numLive;
+        if (freeList == nullptr && unused == unusedEnd)
+        {
+          refill();
+        }
+        if (freeList != nullptr)
+        {
+          FreeSlot *slot = freeList;
+          freeList = slot->next;
+          --numFree;
+          return slot;
+        }
+        void *slot = unused;
+        unused += sizeof(NodeType);
+        return slot;
+    }
+
+    // returns storage for n NodeTypes side by side, so a run of nodes built together also lies together in memory
+    // every slot of the run is given back on its own with deallocate(); runs never come from the free list, so callers
+    // should prefer allocate() while hasFreeSlots() says it covers what they need, or the pool keeps growing
+    void* allocateRun(size_t n)
+    {
+        numLive += n;
+        size_t bytes = n * sizeof(NodeType);
+        if (static_cast<size_t>(unusedEnd - unused) < bytes)
+        {
+          if (n > slabSlots)
+          {
+            // too long for the next slab: give the run a slab of its own and leave the newest slab as it is
+            return pushSlab(n);
+          }
+          // the rest of the newest slab is too short: its slots go onto the free list and the next slab is started
+          freeUnused();
+          newSlab();
+        }
+        void *run = unused;
+        unused += bytes;
+        return run;
+    }
+
+    // takes back storage from allocate() of any pool of this NodeType; the node must already be destroyed
+    void deallocate(void *p)
+    {
+        pushFree(static_cast<FreeSlot*>(p));
+        --numLive;
+        if (numFree > spillSlots())
+        {
+          spill();
+        }
+    }
+
+    // returns the number of slabs this pool has obtained from the system
+    size_t slabs() const
+    {
+        return numSlabs;
+    }
+
+    // returns the number of slots on the free list, which allocate() hands out before touching any slab
+    size_t freeSlots() const
+    {
+        return numFree;
+    }
+
+    // checks whether the free list holds at least n slots, taking over the orphaned slots first if it does not
+    bool hasFreeSlots(size_t n)
+    {
+        if (numFree < n)
+        {
+          adoptOrphans();
+        }
+        return numFree >= n;
+    }
+
+    // returns the number of slots allocated and not yet deallocated through this pool
+    // may wrap around when nodes allocated by one thread are deallocated by another
+    size_t live() const
+    {
+        return numLive;
+    }
+
+};
+
+
+#endif // __MYNODEPOOL_H__
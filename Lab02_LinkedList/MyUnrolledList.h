@@ -0,0 +1,537 @@
+#ifndef __MYUNROLLEDLIST_H__
+#define __MYUNROLLEDLIST_H__
+
+#include <algorithm>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "MyNodePool.h"
+
+// a doubly linked list that stores up to K data elements per node, so a scan touches contiguous memory
+// offers the iterator/insert/erase interface of MyLinkedList; unlike MyLinkedList, insert and erase invalidate
+// iterators into the node they change and into its neighbours, because data elements move between slots
+template <typename DataType, size_t K = 16>
+class MyUnrolledList
+{
+    static_assert(K >= 2, "a node must be able to hold two data elements to split");
+
+  private:
+
+    struct Node
+    {
+        Node *prev;
+        Node *next;
+        size_t count;       // the number of data elements in slots[0 .. count)
+        typename std::aligned_storage<sizeof(DataType), alignof(DataType)>::type slots[K];
+
+        Node() :
+        prev{nullptr},
+        next{nullptr},
+        count{0}
+        { }
+
+        DataType* at(size_t i)
+        {
+            return reinterpret_cast<DataType*>(slots) + i;
+        }
+    };
+
+    int theSize;        // the number of elements that the list is currently holding
+    Node *head;         // pointer to the head node; does not hold real data
+    Node *tail;         // pointer to the tail node; does not hold real data
+
+    typedef MyNodePool<Node> NodePool;
+
+    static Node* createNode()
+    {
+        return new (NodePool::local().allocate()) Node;
+    }
+
+    // frees the node; its data elements must already be destroyed or moved out
+    static void destroyNode(Node *p)
+    {
+        if (p != nullptr)
+        {
+          p->~Node();
+          NodePool::local().deallocate(p);
+        }
+    }
+
+    // links a new empty node right after pos and returns it
+    Node* linkAfter(Node *pos)
+    {
+        Node *n = createNode();
+        n->prev = pos;
+        n->next = pos->next;
+        pos->next->prev = n;
+        pos->next = n;
+        return n;
+    }
+
+    static void unlink(Node *n)
+    {
+        n->prev->next = n->next;
+        n->next->prev = n->prev;
+    }
+
+    // moves count data elements from src into the empty slots starting at dst
+    static void relocate(DataType *src, size_t count, DataType *dst)
+    {
+        for (size_t k = 0; k < count; ++k)
+        {
+          new (dst + k) DataType(std::move(src[k]));
+          src[k].~DataType();
+        }
+    }
+
+    void init( )
+    {
+        theSize = 0;
+        head = createNode();
+        tail = createNode();
+        head->next = tail;
+        tail->prev = head;
+    }
+
+  public:
+
+    // define the const_iterator class
+    class const_iterator
+    {
+      protected:
+        Node *current;      // the node holding the data element
+        size_t index;       // the slot of the data element inside current
+
+        DataType& retrieve() const
+        {
+            return *current->at(index);
+        }
+
+        const_iterator(Node *p, size_t i) :
+        current{p},
+        index{i}
+        {}
+
+        friend class MyUnrolledList<DataType, K>;
+
+      public:
+        const_iterator() :
+        current{nullptr},
+        index{0}
+        {}
+
+        const DataType& operator* () const
+        {
+            return retrieve();
+        }
+
+        // move to the next data element
+        const_iterator& operator++ ()
+        {
+            if (++index == current->count)
+            {
+              current = current->next;
+              index = 0;
+            }
+            return *this;
+        }
+
+        const_iterator operator++ (int)
+        {
+            const_iterator old = *this;
+            ++(*this);
+            return old;
+        }
+
+        // move to the previous data element
+        const_iterator& operator-- ()
+        {
+            if (index == 0)
+            {
+              current = current->prev;
+              index = current->count;
+            }
+            --index;
+            return *this;
+        }
+
+        const_iterator operator-- (int)
+        {
+            const_iterator old = *this;
+            --(*this);
+            return old;
+        }
+
+        // check whether two iterators point to the same data element
+        bool operator== (const const_iterator& rhs) const
+        {
+            return current == rhs.current && index == rhs.index;
+        }
+
+        bool operator!= (const const_iterator & rhs) const
+        {
+            return !(*this == rhs);
+        }
+
+    };
+
+    // define the iterator class; inherit from class const_iterator
+    class iterator : public const_iterator
+    {
+      protected:
+        iterator(Node *p, size_t i) :
+        const_iterator{p, i}
+        {}
+
+        friend class MyUnrolledList<DataType, K>;
+
+      public:
+        iterator()
+        {}
+
+        DataType& operator* ()
+        {
+            return const_iterator::retrieve();
+        }
+
+        const DataType& operator* () const
+        {
+            return const_iterator::operator*();
+        }
+
+        iterator & operator++ ()
+        {
+            const_iterator::operator++();
+            return *this;
+        }
+
+        iterator operator++ (int)
+        {
+            iterator old = *this;
+            ++(*this);
+            return old;
+        }
+
+        iterator & operator-- ()
+        {
+            const_iterator::operator--();
+            return *this;
+        }
+
+        iterator operator-- (int)
+        {
+            iterator old = *this;
+            --(*this);
+            return old;
+        }
+    };
+
+  public:
+
+    // default constructor
+    MyUnrolledList()
+    {
+        init();
+    }
+
+    // copy constructor
+    MyUnrolledList(const MyUnrolledList& rhs)
+    {
+        init();
+        for (auto & x : rhs)
+        {
+          push_back(x);
+        }
+    }
+
+    // move constructor
+    MyUnrolledList(MyUnrolledList&& rhs) :
+    theSize(rhs.theSize),
+    head(rhs.head),
+    tail(rhs.tail)
+    {
+        rhs.theSize = 0;
+        rhs.head = nullptr;
+        rhs.tail = nullptr;
+    }
+
+    // destructor
+    ~MyUnrolledList()
+    {
+        if (head != nullptr)
+        {
+          clear();
+        }
+        destroyNode(head);
+        destroyNode(tail);
+    }
+
+    // copy assignment
+    MyUnrolledList & operator= (const MyUnrolledList& rhs)
+    {
+        MyUnrolledList copy = rhs;
+        std::swap(*this, copy);
+        return *this;
+    }
+
+    // move assignment
+    MyUnrolledList & operator= (MyUnrolledList && rhs)
+    {
+        std::swap(theSize, rhs.theSize);
+        std::swap(head, rhs.head);
+        std::swap(tail, rhs.tail);
+        return *this;
+    }
+
+    // iterator interface
+    iterator begin()
+    {
+        return {head->next, 0};
+    }
+
+    const_iterator begin() const
+    {
+        return {head->next, 0};
+    }
+
+    iterator end()
+    {
+        return {tail, 0};
+    }
+
+    const_iterator end() const
+    {
+        return {tail, 0};
+    }
+
+    // gets the size of the list
+    int size() const
+    {
+        return theSize;
+    }
+
+    // checks if the list is empty; return True if empty, false otherwise
+    bool empty( ) const
+    {
+        return size() == 0;
+    }
+
+    // deletes all nodes excepts the head and tail
+    void clear( )
+    {
+        Node *n = head->next;
+        while (n != tail)
+        {
+          Node *next = n->next;
+          for (size_t k = 0; k < n->count; ++k)
+          {
+            n->at(k)->~DataType();
+          }
+          destroyNode(n);
+          n = next;
+        }
+        head->next = tail;
+        tail->prev = head;
+        theSize = 0;
+    }
+
+    // return the first data element as mutable
+    DataType& front()
+    {
+        return *begin();
+    }
+
+    const DataType& front() const
+    {
+        return *begin();
+    }
+
+    // return the last data element as mutable
+    DataType& back()
+    {
+        return *--end();
+    }
+
+    const DataType& back() const
+    {
+        return *--end();
+    }
+
+    // construct a data element in place before itr; return iterator pointing to the newly inserted data element
+    // the element is built before anything moves, so the arguments may refer to an element of this list
+    template <typename... Args>
+    iterator emplace(iterator itr, Args&&... args)
+    {
+        DataType value(std::forward<Args>(args)...);
+        Node *n = itr.current;
+        size_t i = itr.index;
+
+        // inserting in front of a node's first element may as well append to the previous node
+        if (i == 0 && n->prev != head && n->prev->count < K)
+        {
+          n = n->prev;
+          i = n->count;
+        }
+        else if (n == tail)
+        {
+          n = linkAfter(tail->prev);
+        }
+        else if (n->count == K)
+        {
+          // split the full node; the upper half moves to a new node behind it
+          Node *m = linkAfter(n);
+          relocate(n->at(K / 2), K - K / 2, m->at(0));
+          m->count = K - K / 2;
+          n->count = K / 2;
+          if (i > K / 2)
+          {
+            n = m;
+            i -= K / 2;
+          }
+        }
+
+        if (i == n->count)
+        {
+          new (n->at(i)) DataType(std::move(value));
+        }
+        else
+        {
+          new (n->at(n->count)) DataType(std::move(*n->at(n->count - 1)));
+          std::move_backward(n->at(i), n->at(n->count - 1), n->at(n->count));
+          *n->at(i) = std::move(value);
+        }
+        ++n->count;
+        ++theSize;
+        return {n, i};
+    }
+
+    // insert x before itr; return iterator pointing to the newly inserted data element
+    iterator insert(iterator itr, const DataType& x)
+    {
+        return emplace(itr, x);
+    }
+
+    iterator insert(iterator itr, DataType&& x)
+    {
+        return emplace(itr, std::move(x));
+    }
+
+    // delete the data element pointed by itr; return the iterator pointing to the data element next to the one being deleted
+    // a node that drops to K / 2 data elements together with its successor absorbs the successor
+    iterator erase(iterator itr)
+    {
+        Node *n = itr.current;
+        size_t i = itr.index;
+        std::move(n->at(i + 1), n->at(n->count), n->at(i));
+        n->at(--n->count)->~DataType();
+        --theSize;
+
+        if (n->count == 0)
+        {
+          Node *next = n->next;
+          unlink(n);
+          destroyNode(n);
+          return {next, 0};
+        }
+        Node *m = n->next;
+        if (m != tail && n->count + m->count <= K / 2)
+        {
+          relocate(m->at(0), m->count, n->at(n->count));
+          n->count += m->count;
+          unlink(m);
+          destroyNode(m);
+        }
+        if (i == n->count)
+        {
+          return {n->next, 0};
+        }
+        return {n, i};
+    }
+
+    // delete the data elements from iterator "from" (inclusive) to iterator "to" (exclusive)
+    // return the iterator pointing to the data element "to" pointed at
+    iterator erase(iterator from, iterator to)
+    {
+        size_t count = 0;
+        for (const_iterator itr = from; itr != to; ++itr)
+        {
+          ++count;
+        }
+        while (count-- > 0)
+        {
+          from = erase(from);
+        }
+        return from;
+    }
+
+    // insert data element x to the very begining of the list
+    void push_front(const DataType& x)
+    {
+        insert(begin(), x);
+    }
+
+    void push_front(DataType&& x)
+    {
+        insert(begin(), std::move(x));
+    }
+
+    // insert data element x to the very end of the list
+    void push_back(const DataType& x)
+    {
+        insert(end(), x);
+    }
+
+    void push_back(DataType&& x)
+    {
+        insert(end(), std::move(x));
+    }
+
+    // delete the very first data element
+    void pop_front()
+    {
+        erase(begin());
+    }
+
+    // delete the very last data element
+    void pop_back( )
+    {
+        erase(--end());
+    }
+
+    // reverse the entire list in place: every node, sentinels included, swaps its links, and every node
+    // reverses its slots; no data element is copied
+    void reverseList()
+    {
+        for (Node *n = head; n != nullptr; n = n->prev)
+        {
+          std::swap(n->prev, n->next);
+          std::reverse(n->at(0), n->at(n->count));
+        }
+        std::swap(head, tail);
+    }
+
+    // append a list to the end of the current one by linking its nodes in; rlist is left empty
+    MyUnrolledList& appendList(MyUnrolledList&& rlist)
+    {
+        if (rlist.empty())
+        {
+          return *this;
+        }
+        Node *first = rlist.head->next;
+        Node *last = rlist.tail->prev;
+        first->prev = tail->prev;
+        tail->prev->next = first;
+        last->next = tail;
+        tail->prev = last;
+        theSize += rlist.theSize;
+        rlist.head->next = rlist.tail;
+        rlist.tail->prev = rlist.head;
+        rlist.theSize = 0;
+        return *this;
+    }
+
+};
+
+
+#endif // __MYUNROLLEDLIST_H__
@@ -0,0 +1,107 @@
+// pushes items distinct longs through MyMPMCQueue with 1, 2, 4 and 8 producer/consumer pairs, and through MySPSCQueue
+// with one pair, and checks that every item came out exactly once; full and empty queues are retried after a yield
+// usage: ./BenchConcurrentQueue [items] [capacity]   (default 2000000 1024); exits with 1 if an item is lost or
+// delivered twice
+// build with -pthread
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "MyConcurrentQueue.h"
+
+using namespace std;
+
+static bool failed = false;
+
+// checks that the items received by all consumers are exactly 0 .. items - 1
+static void checkExactlyOnce(const vector<vector<long> > & received, size_t items)
+{
+    vector<unsigned char> seen(items, 0);
+    size_t total = 0;
+    bool ok = true;
+    for (size_t c = 0; c < received.size(); ++c)
+    {
+      for (size_t k = 0; k < received[c].size(); ++k)
+      {
+        long x = received[c][k];
+        if (x < 0 || static_cast<size_t>(x) >= items || seen[x]++ != 0)
+        {
+          ok = false;
+        }
+      }
+      total += received[c].size();
+    }
+    if (!ok || total != items)
+    {
+      printf("  items lost or duplicated: %zu received\n", total);
+      failed = true;
+    }
+}
+
+// runs pairs producers and pairs consumers on queue and prints the throughput
+template <typename Queue>
+void run(const char *name, Queue & queue, size_t pairs, size_t items)
+{
+    vector<vector<long> > received(pairs);
+    atomic<size_t> remaining(items);
+    vector<thread> threads;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (size_t p = 0; p < pairs; ++p)
+    {
+      threads.push_back(thread([&queue, p, pairs, items]()
+          {
+              // producer p sends p, p + pairs, p + 2 * pairs, ...
+              for (size_t x = p; x < items; x += pairs)
+              {
+                while (!queue.try_enqueue(static_cast<long>(x)))
+                {
+                  this_thread::yield();
+                }
+              }
+          }));
+      threads.push_back(thread([&queue, &received, &remaining, p]()
+          {
+              vector<long> & mine = received[p];
+              long x;
+              while (remaining.load(memory_order_relaxed) > 0)
+              {
+                if (queue.try_dequeue(x))
+                {
+                  mine.push_back(x);
+                  remaining.fetch_sub(1, memory_order_relaxed);
+                }
+                else
+                {
+                  this_thread::yield();
+                }
+              }
+          }));
+    }
+    for (size_t k = 0; k < threads.size(); ++k)
+    {
+      threads[k].join();
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    printf("%s %zuP/%zuC %6.1f M ops/s\n", name, pairs, pairs, items / seconds / 1e6);
+    checkExactlyOnce(received, items);
+}
+
+int main(int argc, char* argv[])
+{
+    size_t items = (argc > 1) ? strtoul(argv[1], nullptr, 10) : 2000000;
+    size_t capacity = (argc > 2) ? strtoul(argv[2], nullptr, 10) : 1024;
+    printf("%zu longs, capacity %zu, %u hardware threads\n", items, capacity, thread::hardware_concurrency());
+
+    for (size_t pairs = 1; pairs <= 8; pairs *= 2)
+    {
+      MyMPMCQueue<long> queue(capacity);
+      run("MPMC", queue, pairs, items);
+    }
+    MySPSCQueue<long> queue(capacity);
+    run("SPSC", queue, 1, items);
+    return failed ? 1 : 0;
+}
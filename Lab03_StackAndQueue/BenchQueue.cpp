@@ -0,0 +1,271 @@
+// queue throughput of MyQueue (its own ring, and on a MyDeque) against the MyVector-based MyQueue the ring replaced
+// (OldQueue below, since that version is gone from the tree) and against std::queue on a std::deque:
+//   a breadth-first search of a 256x256 grid, repeated 300 times
+//   steady-state churn: one enqueue and one dequeue per step on a queue holding 1000 ints
+// usage: ./BenchQueue [repeats] [steps]   (default 300 50000000)
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <memory>
+#include <new>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "MyDeque.h"
+#include "MyQueue.h"
+
+using namespace std;
+
+// the MyQueue this ring replaced, with the parts of MyVector it relied on (storage, insertQueue and reserveQueue) folded
+// in: dataStart and dataEnd wrap with branches, one slot always stays empty, and the ring grows to 2 * capacity + 1
+template <typename DataType>
+class OldQueue
+{
+  private:
+    DataType *data;
+    size_t theSize;         // the slots constructed so far
+    size_t theCapacity;
+    size_t dataStart, dataEnd;
+
+    void insertQueue(const DataType & x, size_t thePosition)
+    {
+        if (thePosition == theSize && thePosition < theCapacity)
+        {
+          new (data + theSize++) DataType(x);
+        }
+        else if (thePosition < theSize)
+        {
+          data[thePosition] = x;
+        }
+    }
+
+    void reserveQueue(size_t newCapacity, size_t from)
+    {
+        DataType *newArray = allocator<DataType>().allocate(newCapacity);
+        for (size_t i = 0, j = from; i < theSize; i++)
+        {
+          new (newArray + i) DataType(std::move(data[j]));
+          if (j == (theCapacity - 1))
+          {
+            j = 0;
+          }
+          else
+          {
+            j++;
+          }
+        }
+        for (size_t k = 0; k < theSize; ++k)
+        {
+          data[k].~DataType();
+        }
+        allocator<DataType>().deallocate(data, theCapacity);
+        data = newArray;
+        theCapacity = newCapacity;
+    }
+
+    void reserve(size_t newCapacity)
+    {
+        size_t tempReserve = capacity();
+        reserveQueue(newCapacity, dataStart);
+        dataStart = 0;
+        dataEnd = (tempReserve - 2);
+    }
+
+  public:
+    OldQueue() :
+        data{allocator<DataType>().allocate(16)},
+        theSize{0},
+        theCapacity{16},
+        dataStart{0},
+        dataEnd{15}
+    {
+
+    }
+
+    ~OldQueue()
+    {
+        for (size_t k = 0; k < theSize; ++k)
+        {
+          data[k].~DataType();
+        }
+        allocator<DataType>().deallocate(data, theCapacity);
+    }
+
+    void enqueue(const DataType & x)
+    {
+        if (size() == (capacity() - 1))
+        {
+          reserve(2 * (capacity()) + 1);
+        }
+        if (dataEnd == (capacity() - 1))
+        {
+          dataEnd = 0;
+        }
+        else
+        {
+          dataEnd++;
+        }
+        insertQueue(x, dataEnd);
+    }
+
+    void dequeue()
+    {
+        if (dataStart == (capacity() - 1))
+        {
+          dataStart = 0;
+        }
+        else
+        {
+          dataStart++;
+        }
+    }
+
+    const DataType & front() const
+    {
+        return data[dataStart];
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    size_t size() const
+    {
+        long tempSize = static_cast<long>(dataEnd) - static_cast<long>(dataStart);
+        if (tempSize == -1 || tempSize == static_cast<long>(capacity() - 1))
+        {
+          return 0;
+        }
+        else if (tempSize >= 0)
+        {
+          return (tempSize + 1);
+        }
+        else
+        {
+          return (tempSize + capacity() + 1);
+        }
+    }
+
+    size_t capacity() const
+    {
+        return theCapacity;
+    }
+};
+
+// std::queue behind MyQueue's member names
+template <typename DataType>
+class StdQueue
+{
+  private:
+    queue<DataType, deque<DataType> > q;
+
+  public:
+    void enqueue(const DataType & x)
+    {
+        q.push(x);
+    }
+
+    void dequeue()
+    {
+        q.pop();
+    }
+
+    DataType & front()
+    {
+        return q.front();
+    }
+
+    bool empty() const
+    {
+        return q.empty();
+    }
+};
+
+static const int SIDE = 256;
+
+// breadth-first search from the corner of a SIDE x SIDE grid; returns the sum of the distances
+template <typename Queue>
+long long gridBfs(vector<int> & dist)
+{
+    fill(dist.begin(), dist.end(), -1);
+    Queue q;
+    dist[0] = 0;
+    q.enqueue(0);
+    long long sum = 0;
+    while (!q.empty())
+    {
+      int cell = q.front();
+      q.dequeue();
+      sum += dist[cell];
+      int row = cell / SIDE;
+      int col = cell % SIDE;
+      int next[4] = { (row > 0) ? cell - SIDE : -1, (row < SIDE - 1) ? cell + SIDE : -1,
+                      (col > 0) ? cell - 1 : -1, (col < SIDE - 1) ? cell + 1 : -1 };
+      for (int k = 0; k < 4; ++k)
+      {
+        if (next[k] >= 0 && dist[next[k]] < 0)
+        {
+          dist[next[k]] = dist[cell] + 1;
+          q.enqueue(next[k]);
+        }
+      }
+    }
+    return sum;
+}
+
+template <typename Queue>
+void timeBfs(const char *name, size_t repeats)
+{
+    vector<int> dist(SIDE * SIDE);
+    long long sum = 0;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (size_t r = 0; r < repeats; ++r)
+    {
+      sum += gridBfs<Queue>(dist);
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    // every cell is enqueued once and dequeued once
+    double ops = 2.0 * SIDE * SIDE * repeats;
+    printf("grid BFS x%zu  %-22s %6.1f M queue ops/s (checksum %lld)\n", repeats, name, ops / seconds / 1e6, sum);
+}
+
+template <typename Queue>
+void timeChurn(const char *name, size_t steps)
+{
+    Queue q;
+    for (int k = 0; k < 1000; ++k)
+    {
+      q.enqueue(k);
+    }
+    long long sum = 0;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (size_t k = 0; k < steps; ++k)
+    {
+      q.enqueue(static_cast<int>(k));
+      sum += q.front();
+      q.dequeue();
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    printf("churn (1000)  %-22s %6.1f M enqueue+dequeue/s (checksum %lld)\n", name, steps / seconds / 1e6, sum);
+}
+
+int main(int argc, char* argv[])
+{
+    size_t repeats = (argc > 1) ? strtoul(argv[1], nullptr, 10) : 300;
+    size_t steps = (argc > 2) ? strtoul(argv[2], nullptr, 10) : 50000000;
+
+    timeBfs<OldQueue<int> >("old MyQueue", repeats);
+    timeBfs<StdQueue<int> >("std::queue", repeats);
+    timeBfs<MyQueue<int, MyDeque<int> > >("MyQueue on MyDeque", repeats);
+    timeBfs<MyQueue<int> >("MyQueue", repeats);
+    timeChurn<OldQueue<int> >("old MyQueue", steps);
+    timeChurn<StdQueue<int> >("std::queue", steps);
+    timeChurn<MyQueue<int, MyDeque<int> > >("MyQueue on MyDeque", steps);
+    timeChurn<MyQueue<int> >("MyQueue", steps);
+    return 0;
+}
@@ -0,0 +1,301 @@
+#ifndef __MYCONCURRENTQUEUE_H__
+#define __MYCONCURRENTQUEUE_H__
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// bounded lock-free queues for handing data elements between threads
+//
+//   MyMPMCQueue    any number of producer and consumer threads
+//   MySPSCQueue    exactly one producer thread and one consumer thread; cheaper per operation
+//
+// the capacity is rounded up to a power of two and never changes; try_enqueue() returns false when the queue is full
+// and try_dequeue() returns false when it is empty, so neither ever blocks
+// programs using these need to be linked with -pthread
+
+// rounds n up to a power of two (at least 2)
+inline size_t queueCapacityFor(size_t n)
+{
+    size_t c = 2;
+    while (c < n)
+    {
+      c *= 2;
+    }
+    return c;
+}
+
+// multi-producer multi-consumer queue: every slot carries a sequence number telling whether it is ready to be
+// written or read for the current lap, so a producer or consumer only contends on the one index it advances
+template <typename DataType>
+class MyMPMCQueue
+{
+  private:
+    // the spacing that keeps indices written by different threads on different cache lines
+    static const size_t CACHE_LINE_SIZE = 64;
+
+    struct Slot
+    {
+        std::atomic<size_t> sequence;
+        typename std::aligned_storage<sizeof(DataType), alignof(DataType)>::type storage;
+
+        DataType* value()
+        {
+            return reinterpret_cast<DataType*>(&storage);
+        }
+    };
+
+    Slot *slots;
+    size_t mask;                                            // capacity - 1
+    char pad0[CACHE_LINE_SIZE];
+    std::atomic<size_t> enqueuePos;                         // the next position producers claim
+    char pad1[CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+    std::atomic<size_t> dequeuePos;                         // the next position consumers claim
+    char pad2[CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+
+    // claims the next position to write; returns nullptr if the queue is full
+    Slot* claimEnqueue(size_t & pos)
+    {
+        pos = enqueuePos.load(std::memory_order_relaxed);
+        while (true)
+        {
+          Slot *slot = &slots[pos & mask];
+          size_t seq = slot->sequence.load(std::memory_order_acquire);
+          long long diff = static_cast<long long>(seq - pos);
+          if (diff == 0)
+          {
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+              return slot;
+            }
+          }
+          else if (diff < 0)
+          {
+            return nullptr;
+          }
+          else
+          {
+            pos = enqueuePos.load(std::memory_order_relaxed);
+          }
+        }
+    }
+
+  public:
+
+    explicit MyMPMCQueue(size_t capacity) :
+        mask{queueCapacityFor(capacity) - 1},
+        enqueuePos{0},
+        dequeuePos{0}
+    {
+        slots = new Slot[mask + 1];
+        for (size_t k = 0; k <= mask; ++k)
+        {
+          slots[k].sequence.store(k, std::memory_order_relaxed);
+        }
+    }
+
+    MyMPMCQueue(const MyMPMCQueue & rhs) = delete;
+    MyMPMCQueue & operator= (const MyMPMCQueue & rhs) = delete;
+
+    // destroys the data elements still in the queue; no other thread may be using it
+    ~MyMPMCQueue()
+    {
+        size_t end = enqueuePos.load(std::memory_order_acquire);
+        for (size_t pos = dequeuePos.load(std::memory_order_relaxed); pos != end; ++pos)
+        {
+          slots[pos & mask].value()->~DataType();
+        }
+        delete [] slots;
+    }
+
+    // construct a data element in place at the back; returns false if the queue is full
+    template <typename... Args>
+    bool try_emplace(Args&&... args)
+    {
+        size_t pos;
+        Slot *slot = claimEnqueue(pos);
+        if (slot == nullptr)
+        {
+          return false;
+        }
+        new (slot->value()) DataType(std::forward<Args>(args)...);
+        slot->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // insert x at the back; returns false if the queue is full
+    bool try_enqueue(const DataType & x)
+    {
+        return try_emplace(x);
+    }
+
+    bool try_enqueue(DataType && x)
+    {
+        return try_emplace(std::move(x));
+    }
+
+    // move the front data element into x; returns false if the queue is empty
+    bool try_dequeue(DataType & x)
+    {
+        size_t pos = dequeuePos.load(std::memory_order_relaxed);
+        Slot *slot;
+        while (true)
+        {
+          slot = &slots[pos & mask];
+          size_t seq = slot->sequence.load(std::memory_order_acquire);
+          long long diff = static_cast<long long>(seq - (pos + 1));
+          if (diff == 0)
+          {
+            if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+              break;
+            }
+          }
+          else if (diff < 0)
+          {
+            return false;
+          }
+          else
+          {
+            pos = dequeuePos.load(std::memory_order_relaxed);
+          }
+        }
+        x = std::move(*slot->value());
+        slot->value()->~DataType();
+        slot->sequence.store(pos + mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    // returns the number of data elements; only a snapshot while other threads are active
+    size_t size_approx() const
+    {
+        size_t e = enqueuePos.load(std::memory_order_relaxed);
+        size_t d = dequeuePos.load(std::memory_order_relaxed);
+        return (e > d) ? e - d : 0;
+    }
+
+    // returns the capacity of the queue
+    size_t capacity() const
+    {
+        return mask + 1;
+    }
+
+};
+
+// single-producer single-consumer queue: each side owns one index and keeps a cached copy of the other side's,
+// so it only reads the shared cache line of the other side when the cached copy says full or empty
+template <typename DataType>
+class MySPSCQueue
+{
+  private:
+    // the spacing that keeps indices written by different threads on different cache lines
+    static const size_t CACHE_LINE_SIZE = 64;
+
+    typedef typename std::aligned_storage<sizeof(DataType), alignof(DataType)>::type Storage;
+
+    Storage *buffer;
+    size_t mask;                                            // capacity - 1
+    char pad0[CACHE_LINE_SIZE];
+    std::atomic<size_t> tail;                               // written by the producer
+    size_t headCache;                                       // the producer's copy of head
+    char pad1[CACHE_LINE_SIZE - sizeof(std::atomic<size_t>) - sizeof(size_t)];
+    std::atomic<size_t> head;                               // written by the consumer
+    size_t tailCache;                                       // the consumer's copy of tail
+    char pad2[CACHE_LINE_SIZE - sizeof(std::atomic<size_t>) - sizeof(size_t)];
+
+    DataType* at(size_t pos)
+    {
+        return reinterpret_cast<DataType*>(&buffer[pos & mask]);
+    }
+
+  public:
+
+    explicit MySPSCQueue(size_t capacity) :
+        mask{queueCapacityFor(capacity) - 1},
+        tail{0},
+        headCache{0},
+        head{0},
+        tailCache{0}
+    {
+        buffer = new Storage[mask + 1];
+    }
+
+    MySPSCQueue(const MySPSCQueue & rhs) = delete;
+    MySPSCQueue & operator= (const MySPSCQueue & rhs) = delete;
+
+    // destroys the data elements still in the queue; no other thread may be using it
+    ~MySPSCQueue()
+    {
+        size_t t = tail.load(std::memory_order_acquire);
+        for (size_t h = head.load(std::memory_order_relaxed); h != t; ++h)
+        {
+          at(h)->~DataType();
+        }
+        delete [] buffer;
+    }
+
+    // construct a data element in place at the back; producer thread only
+    template <typename... Args>
+    bool try_emplace(Args&&... args)
+    {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t - headCache > mask)
+        {
+          headCache = head.load(std::memory_order_acquire);
+          if (t - headCache > mask)
+          {
+            return false;
+          }
+        }
+        new (at(t)) DataType(std::forward<Args>(args)...);
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // insert x at the back; returns false if the queue is full; producer thread only
+    bool try_enqueue(const DataType & x)
+    {
+        return try_emplace(x);
+    }
+
+    bool try_enqueue(DataType && x)
+    {
+        return try_emplace(std::move(x));
+    }
+
+    // move the front data element into x; returns false if the queue is empty; consumer thread only
+    bool try_dequeue(DataType & x)
+    {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h == tailCache)
+        {
+          tailCache = tail.load(std::memory_order_acquire);
+          if (h == tailCache)
+          {
+            return false;
+          }
+        }
+        x = std::move(*at(h));
+        at(h)->~DataType();
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // returns the number of data elements; only a snapshot while other threads are active
+    size_t size_approx() const
+    {
+        return tail.load(std::memory_order_relaxed) - head.load(std::memory_order_relaxed);
+    }
+
+    // returns the capacity of the queue
+    size_t capacity() const
+    {
+        return mask + 1;
+    }
+
+};
+
+
+#endif // __MYCONCURRENTQUEUE_H__
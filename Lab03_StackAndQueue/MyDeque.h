@@ -0,0 +1,289 @@
+#ifndef __MYDEQUE_H__
+#define __MYDEQUE_H__
+
+#include <algorithm>
+#include <new>
+#include <utility>
+
+#include "MyVector.h"
+
+// a double-ended queue storing its data elements in fixed-size blocks reached through a map of block pointers
+// push and pop at either end are O(1) and never move existing data elements, so references stay valid until the
+// element is removed; growing only reallocates the map, which holds one pointer per block
+// can back MyStack (MyStack<T, MyDeque<T> >) and MyQueue (MyQueue<T, MyDeque<T> >)
+template <typename DataType>
+class MyDeque
+{
+  public:
+
+    // the number of data elements per block; a block is about 4 KiB, and at least 16 elements
+    static const size_t BLOCK_SIZE = (sizeof(DataType) <= 256) ? 4096 / sizeof(DataType) : 16;
+
+  private:
+
+    MyVector<DataType*> map;    // the block pointers; exactly the blocks overlapping [first, first + theSize) are allocated
+    size_t first;               // the position of the front data element, counted in slots from the start of map[0]
+    size_t theSize;             // the number of data elements in the deque
+    size_t numBlocks;           // the number of blocks currently allocated
+    DataType *spare;            // the most recently released block, kept so that a push right after a pop does not allocate
+
+    DataType* slot(size_t pos) const
+    {
+        return map[pos / BLOCK_SIZE] + pos % BLOCK_SIZE;
+    }
+
+    // makes sure the block holding position pos is allocated
+    void acquireBlock(size_t pos)
+    {
+        DataType *&block = map[pos / BLOCK_SIZE];
+        if (block == nullptr)
+        {
+          if (spare != nullptr)
+          {
+            block = spare;
+            spare = nullptr;
+          }
+          else
+          {
+            block = static_cast<DataType*>(::operator new(BLOCK_SIZE * sizeof(DataType)));
+          }
+          ++numBlocks;
+        }
+    }
+
+    // gives back the block holding position pos; it must hold no data element any more
+    void releaseBlock(size_t pos)
+    {
+        DataType *&block = map[pos / BLOCK_SIZE];
+        if (spare == nullptr)
+        {
+          spare = block;
+        }
+        else
+        {
+          ::operator delete(block);
+        }
+        block = nullptr;
+        --numBlocks;
+    }
+
+    // re-centres the block pointers in a map with free slots on both sides, growing the map to twice the blocks in use
+    // when it is more than half full; called when a push finds no free map slot on its side; no data element moves
+    void reallocateMap()
+    {
+        size_t firstBlock = first / BLOCK_SIZE;
+        size_t usedBlocks = (theSize == 0) ? 0 : (first + theSize - 1) / BLOCK_SIZE - firstBlock + 1;
+        size_t newMapSize = std::max(map.size(), 2 * (usedBlocks + 1));
+        MyVector<DataType*> newMap(newMapSize);
+        size_t newFirstBlock = (newMapSize - usedBlocks) / 2;
+        for (size_t b = 0; b < usedBlocks; ++b)
+        {
+          newMap[newFirstBlock + b] = map[firstBlock + b];
+        }
+        first = newFirstBlock * BLOCK_SIZE + first % BLOCK_SIZE;
+        std::swap(map, newMap);
+    }
+
+    void init()
+    {
+        first = map.size() / 2 * BLOCK_SIZE;
+        theSize = 0;
+        numBlocks = 0;
+        spare = nullptr;
+    }
+
+  public:
+
+    // default constructor
+    MyDeque() :
+        map(2)
+    {
+        init();
+    }
+
+    // copy constructor
+    MyDeque(const MyDeque & rhs) :
+        map(2)
+    {
+        init();
+        for (size_t i = 0; i < rhs.size(); ++i)
+        {
+          push_back(rhs[i]);
+        }
+    }
+
+    // move constructor
+    MyDeque(MyDeque && rhs) :
+        map(2)
+    {
+        init();
+        swap(rhs);
+    }
+
+    // destructor
+    ~MyDeque()
+    {
+        clear();
+        ::operator delete(spare);
+    }
+
+    // copy assignment
+    MyDeque & operator= (const MyDeque & rhs)
+    {
+        MyDeque copy = rhs;
+        swap(copy);
+        return *this;
+    }
+
+    // move assignment
+    MyDeque & operator= (MyDeque && rhs)
+    {
+        swap(rhs);
+        return *this;
+    }
+
+    void swap(MyDeque & rhs)
+    {
+        std::swap(map, rhs.map);
+        std::swap(first, rhs.first);
+        std::swap(theSize, rhs.theSize);
+        std::swap(numBlocks, rhs.numBlocks);
+        std::swap(spare, rhs.spare);
+    }
+
+    // data access operator (without bound checking)
+    DataType & operator[] (size_t index)
+    {
+        return *slot(first + index);
+    }
+
+    const DataType & operator[](size_t index) const
+    {
+        return *slot(first + index);
+    }
+
+    // check if the deque is empty; return TRUE if the deque is empty
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    // returns the size of the deque
+    size_t size() const
+    {
+        return theSize;
+    }
+
+    // returns the number of data elements the allocated blocks can hold
+    size_t capacity() const
+    {
+        return numBlocks * BLOCK_SIZE;
+    }
+
+    // remove all data elements and release every block except the spare one
+    void clear()
+    {
+        while (!empty())
+        {
+          pop_back();
+        }
+    }
+
+    // construct a data element in place at the back of the deque
+    template <typename... Args>
+    void emplace_back(Args&&... args)
+    {
+        if (first + theSize == map.size() * BLOCK_SIZE)
+        {
+          reallocateMap();
+        }
+        size_t pos = first + theSize;
+        acquireBlock(pos);
+        new (slot(pos)) DataType(std::forward<Args>(args)...);
+        ++theSize;
+    }
+
+    // construct a data element in place at the front of the deque
+    template <typename... Args>
+    void emplace_front(Args&&... args)
+    {
+        if (first == 0)
+        {
+          reallocateMap();
+        }
+        size_t pos = first - 1;
+        acquireBlock(pos);
+        new (slot(pos)) DataType(std::forward<Args>(args)...);
+        --first;
+        ++theSize;
+    }
+
+    // insert an data element to the back / front of the deque
+    void push_back(const DataType & x)
+    {
+        emplace_back(x);
+    }
+
+    void push_back(DataType && x)
+    {
+        emplace_back(std::move(x));
+    }
+
+    void push_front(const DataType & x)
+    {
+        emplace_front(x);
+    }
+
+    void push_front(DataType && x)
+    {
+        emplace_front(std::move(x));
+    }
+
+    // remove the last data element
+    void pop_back()
+    {
+        size_t pos = first + --theSize;
+        slot(pos)->~DataType();
+        if (pos % BLOCK_SIZE == 0 || theSize == 0)
+        {
+          releaseBlock(pos);
+        }
+    }
+
+    // remove the first data element
+    void pop_front()
+    {
+        size_t pos = first++;
+        slot(pos)->~DataType();
+        --theSize;
+        if (pos % BLOCK_SIZE == BLOCK_SIZE - 1 || theSize == 0)
+        {
+          releaseBlock(pos);
+        }
+    }
+
+    // access the first / last data element
+    DataType & front()
+    {
+        return *slot(first);
+    }
+
+    const DataType & front() const
+    {
+        return *slot(first);
+    }
+
+    DataType & back()
+    {
+        return *slot(first + theSize - 1);
+    }
+
+    const DataType & back() const
+    {
+        return *slot(first + theSize - 1);
+    }
+
+};
+
+
+#endif // __MYDEQUE_H__
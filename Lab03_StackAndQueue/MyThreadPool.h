@@ -0,0 +1,339 @@
+#ifndef __MYTHREADPOOL_H__
+#define __MYTHREADPOOL_H__
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "MyQueue.h"
+#include "MyVector.h"
+#include "MyWorkStealingDeque.h"
+
+// a fixed pool of worker threads, each owning a MyWorkStealingDeque of tasks
+// a task submitted from a worker goes onto that worker's own deque (most recent first, like a DFS frontier on a
+// MyStack); a task submitted from any other thread goes into a shared injection queue; idle workers steal the oldest
+// tasks of the others, so a recursive split spreads across the pool
+// use MyTaskGroup for fork/join: its wait() runs pending tasks instead of blocking, so nested waits cannot deadlock
+// programs using this need to be linked with -pthread
+class MyThreadPool
+{
+  public:
+    typedef std::function<void()> Task;
+
+  private:
+    struct Worker
+    {
+        MyWorkStealingDeque<Task*> tasks;
+        std::thread thread;
+    };
+
+    MyVector<Worker*> workers;
+    MyQueue<Task*> injected;                // tasks submitted from outside the pool; guarded by lock
+    std::mutex lock;
+    std::condition_variable wakeUp;         // signalled when a task is submitted or the pool stops
+    std::condition_variable allDone;        // signalled when the last unfinished task completes
+    std::atomic<size_t> queued;             // tasks submitted and not yet started
+    std::atomic<size_t> unfinished;         // tasks submitted and not yet completed
+    std::atomic<size_t> sleepers;           // workers waiting on wakeUp
+    std::atomic<size_t> numSteals;          // tasks taken from another worker's deque
+    bool stopping;                          // guarded by lock
+
+    // the index of the calling worker in its pool, or -1 outside any pool
+    static int& workerIndex()
+    {
+        static thread_local int index = -1;
+        return index;
+    }
+
+    static MyThreadPool*& workerPool()
+    {
+        static thread_local MyThreadPool *pool = nullptr;
+        return pool;
+    }
+
+    int self() const
+    {
+        return (workerPool() == this) ? workerIndex() : -1;
+    }
+
+    // finds a task: the caller's own deque first, then the injection queue, then the other workers' deques
+    Task* takeTask(int me)
+    {
+        Task *task = nullptr;
+        if (me >= 0 && workers[me]->tasks.pop(task))
+        {
+          return task;
+        }
+        if (queued.load(std::memory_order_relaxed) == 0)
+        {
+          return nullptr;
+        }
+        {
+          std::lock_guard<std::mutex> guard(lock);
+          if (!injected.empty())
+          {
+            task = injected.front();
+            injected.dequeue();
+            return task;
+          }
+        }
+        size_t n = workers.size();
+        size_t start = (me >= 0) ? me + 1 : 0;
+        for (size_t k = 0; k < n; ++k)
+        {
+          size_t victim = (start + k) % n;
+          if (static_cast<int>(victim) != me && workers[victim]->tasks.steal(task))
+          {
+            numSteals.fetch_add(1, std::memory_order_relaxed);
+            return task;
+          }
+        }
+        return nullptr;
+    }
+
+    void execute(Task *task)
+    {
+        queued.fetch_sub(1);
+        (*task)();
+        delete task;
+        if (unfinished.fetch_sub(1) == 1)
+        {
+          std::lock_guard<std::mutex> guard(lock);
+          allDone.notify_all();
+        }
+    }
+
+    void workerLoop(int me)
+    {
+        workerIndex() = me;
+        workerPool() = this;
+        while (true)
+        {
+          Task *task = takeTask(me);
+          if (task != nullptr)
+          {
+            execute(task);
+            continue;
+          }
+          // sleepers and queued are both sequentially consistent, so either submit() sees this worker asleep
+          // or this worker sees the new task
+          std::unique_lock<std::mutex> guard(lock);
+          sleepers.fetch_add(1);
+          while (queued.load() == 0 && !stopping)
+          {
+            wakeUp.wait(guard);
+          }
+          sleepers.fetch_sub(1);
+          if (stopping && queued.load() == 0)
+          {
+            return;
+          }
+        }
+    }
+
+  public:
+
+    // starts numThreads workers; 0 means one per hardware thread
+    explicit MyThreadPool(size_t numThreads = 0) :
+        queued{0},
+        unfinished{0},
+        sleepers{0},
+        numSteals{0},
+        stopping{false}
+    {
+        if (numThreads == 0)
+        {
+          numThreads = std::thread::hardware_concurrency();
+        }
+        if (numThreads == 0)
+        {
+          numThreads = 1;
+        }
+        for (size_t k = 0; k < numThreads; ++k)
+        {
+          workers.push_back(new Worker);
+        }
+        for (size_t k = 0; k < numThreads; ++k)
+        {
+          workers[k]->thread = std::thread(&MyThreadPool::workerLoop, this, static_cast<int>(k));
+        }
+    }
+
+    MyThreadPool(const MyThreadPool & rhs) = delete;
+    MyThreadPool & operator= (const MyThreadPool & rhs) = delete;
+
+    // finishes every submitted task, then stops the workers
+    ~MyThreadPool()
+    {
+        waitIdle();
+        {
+          std::lock_guard<std::mutex> guard(lock);
+          stopping = true;
+        }
+        wakeUp.notify_all();
+        // every worker may still be stealing from the others until it returns, so none is freed before all are joined
+        for (size_t k = 0; k < workers.size(); ++k)
+        {
+          workers[k]->thread.join();
+        }
+        for (size_t k = 0; k < workers.size(); ++k)
+        {
+          delete workers[k];
+        }
+    }
+
+    // schedules task to run on some worker
+    void submit(Task task)
+    {
+        Task *t = new Task(std::move(task));
+        unfinished.fetch_add(1);
+        int me = self();
+        // counted before it becomes visible, so queued never drops below the tasks actually waiting
+        queued.fetch_add(1);
+        if (me >= 0)
+        {
+          workers[me]->tasks.push(t);
+        }
+        else
+        {
+          std::lock_guard<std::mutex> guard(lock);
+          injected.enqueue(t);
+        }
+        if (sleepers.load() > 0)
+        {
+          std::lock_guard<std::mutex> guard(lock);
+          wakeUp.notify_one();
+        }
+    }
+
+    // runs one pending task on the calling thread; returns false if none could be found
+    bool runPendingTask()
+    {
+        Task *task = takeTask(self());
+        if (task == nullptr)
+        {
+          return false;
+        }
+        execute(task);
+        return true;
+    }
+
+    // runs the newest task on the calling worker's own deque; returns false if there is none or the caller is not a
+    // worker of this pool
+    bool runOwnTask()
+    {
+        int me = self();
+        Task *task = nullptr;
+        if (me < 0 || !workers[me]->tasks.pop(task))
+        {
+          return false;
+        }
+        execute(task);
+        return true;
+    }
+
+    // blocks until every submitted task has completed; must not be called from a worker
+    void waitIdle()
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        while (unfinished.load() != 0)
+        {
+          allDone.wait(guard);
+        }
+    }
+
+    // returns the number of worker threads
+    size_t size() const
+    {
+        return workers.size();
+    }
+
+    // returns the index (0 to size() - 1) of the calling worker thread, or -1 when called from outside the pool
+    // lets tasks keep per-worker state in a vector instead of locking shared state
+    int workerId() const
+    {
+        return self();
+    }
+
+    // returns how many tasks were taken from another worker's deque so far
+    size_t steals() const
+    {
+        return numSteals.load(std::memory_order_relaxed);
+    }
+
+};
+
+// a set of tasks to join on; wait() helps running pool tasks until all tasks of the group are done
+// a task run while helping may wait on a group of its own and help again, so the helping nests on the stack; past
+// maxHelpDepth() nested helps a thread only runs tasks from its own deque, which were pushed by the tasks it is
+// already running, so the nesting grows no deeper than the recursion of the tasks themselves
+class MyTaskGroup
+{
+  private:
+    MyThreadPool & pool;
+    std::atomic<size_t> pending;
+
+    static constexpr size_t maxHelpDepth()
+    {
+        return 64;
+    }
+
+    // the number of tasks the calling thread is running from inside wait()
+    static size_t& helpDepth()
+    {
+        static thread_local size_t depth = 0;
+        return depth;
+    }
+
+  public:
+
+    explicit MyTaskGroup(MyThreadPool & p) :
+        pool(p),
+        pending{0}
+    {
+
+    }
+
+    MyTaskGroup(const MyTaskGroup & rhs) = delete;
+    MyTaskGroup & operator= (const MyTaskGroup & rhs) = delete;
+
+    ~MyTaskGroup()
+    {
+        wait();
+    }
+
+    // schedules f on the pool as part of this group
+    template <typename Function>
+    void run(Function f)
+    {
+        pending.fetch_add(1);
+        pool.submit([this, f]() mutable
+            {
+                f();
+                pending.fetch_sub(1, std::memory_order_release);
+            });
+    }
+
+    // returns once every task of the group has completed, running pool tasks meanwhile
+    void wait()
+    {
+        size_t & depth = helpDepth();
+        while (pending.load(std::memory_order_acquire) != 0)
+        {
+          ++depth;
+          bool ran = (depth <= maxHelpDepth()) ? pool.runPendingTask() : pool.runOwnTask();
+          --depth;
+          if (!ran)
+          {
+            std::this_thread::yield();
+          }
+        }
+    }
+
+};
+
+
+#endif // __MYTHREADPOOL_H__
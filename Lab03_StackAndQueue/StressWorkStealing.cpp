@@ -0,0 +1,157 @@
+// stress test of MyWorkStealingDeque and MyThreadPool
+//   deque: one owner pushes items ints and pops a third of them back while 3 thieves steal; every item must be taken
+//          exactly once
+//   pool:  rounds of creating a pool, submitting tasks from outside and from the workers, and destroying it right away,
+//          so workers are still stealing from each other as the pool shuts down; every task must run exactly once
+//   fib:   fib(32) split with MyTaskGroup down to fib(12), on 1, 2, 4 and 8 workers
+// usage: ./StressWorkStealing [items] [rounds]   (default 2000000 200); exits with 1 if a check fails
+// build with -pthread
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "MyThreadPool.h"
+#include "MyWorkStealingDeque.h"
+
+using namespace std;
+
+static bool failed = false;
+
+static void checkDeque(size_t items)
+{
+    MyWorkStealingDeque<int> deque(64);
+    vector<vector<int> > taken(4);
+    atomic<bool> done(false);
+    vector<thread> thieves;
+    for (size_t t = 1; t < taken.size(); ++t)
+    {
+      thieves.push_back(thread([&deque, &taken, &done, t]()
+          {
+              int x;
+              // the last check after done is seen picks up whatever the owner left behind
+              while (true)
+              {
+                bool last = done.load();
+                while (deque.steal(x))
+                {
+                  taken[t].push_back(x);
+                }
+                if (last)
+                {
+                  break;
+                }
+                this_thread::yield();
+              }
+          }));
+    }
+    int x;
+    for (size_t k = 0; k < items; ++k)
+    {
+      deque.push(static_cast<int>(k));
+      if (k % 3 == 0 && deque.pop(x))
+      {
+        taken[0].push_back(x);
+      }
+    }
+    while (deque.pop(x))
+    {
+      taken[0].push_back(x);
+    }
+    done.store(true);
+    for (size_t t = 0; t < thieves.size(); ++t)
+    {
+      thieves[t].join();
+    }
+
+    vector<unsigned char> seen(items, 0);
+    size_t total = 0;
+    bool ok = true;
+    for (size_t t = 0; t < taken.size(); ++t)
+    {
+      for (size_t k = 0; k < taken[t].size(); ++k)
+      {
+        if (taken[t][k] < 0 || static_cast<size_t>(taken[t][k]) >= items || seen[taken[t][k]]++ != 0)
+        {
+          ok = false;
+        }
+      }
+      total += taken[t].size();
+    }
+    printf("deque: %zu items, owner popped %zu, thieves stole %zu / %zu / %zu: %s\n", items, taken[0].size(),
+           taken[1].size(), taken[2].size(), taken[3].size(), (ok && total == items) ? "each exactly once" : "FAILED");
+    failed = failed || !ok || total != items;
+}
+
+static void checkPoolRounds(size_t rounds)
+{
+    atomic<size_t> ran(0);
+    size_t expected = 0;
+    for (size_t r = 0; r < rounds; ++r)
+    {
+      MyThreadPool pool(1 + r % 4);
+      // each outside task submits two more from its worker, so the tasks land on the deques and get stolen
+      for (int k = 0; k < 32; ++k)
+      {
+        pool.submit([&pool, &ran]()
+            {
+                ran.fetch_add(1);
+                for (int j = 0; j < 2; ++j)
+                {
+                  pool.submit([&ran]() { ran.fetch_add(1); });
+                }
+            });
+      }
+      expected += 32 * 3;
+    }
+    printf("pool: %zu create/submit/destroy rounds, %zu of %zu tasks ran: %s\n", rounds, ran.load(), expected,
+           (ran.load() == expected) ? "ok" : "FAILED");
+    failed = failed || ran.load() != expected;
+}
+
+static long long fibSerial(int n)
+{
+    return (n < 2) ? n : fibSerial(n - 1) + fibSerial(n - 2);
+}
+
+static long long fib(MyThreadPool & pool, int n)
+{
+    if (n < 12)
+    {
+      return fibSerial(n);
+    }
+    long long a = 0;
+    MyTaskGroup group(pool);
+    group.run([&pool, &a, n]() { a = fib(pool, n - 1); });
+    long long b = fib(pool, n - 2);
+    group.wait();
+    return a + b;
+}
+
+static void timeFib()
+{
+    for (size_t workers = 1; workers <= 8; workers *= 2)
+    {
+      MyThreadPool pool(workers);
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      long long result = fib(pool, 32);
+      double millis = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+      printf("fib(32) on %zu workers: %7.1f ms, %zu steals%s\n", workers, millis, pool.steals(),
+             (result == 2178309) ? "" : "  WRONG RESULT");
+      failed = failed || result != 2178309;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    size_t items = (argc > 1) ? strtoul(argv[1], nullptr, 10) : 2000000;
+    size_t rounds = (argc > 2) ? strtoul(argv[2], nullptr, 10) : 200;
+    printf("%u hardware threads\n", thread::hardware_concurrency());
+    checkDeque(items);
+    checkPoolRounds(rounds);
+    timeFib();
+    return failed ? 1 : 0;
+}
@@ -1,3 +1,4 @@
+#include <cstdlib>
 #include <iostream>
 #include <iomanip>
 #include <vector>
@@ -5,11 +6,34 @@
 #include <string>
 
 #include "MyInfixCalculator.h"
+#include "MyBatchCalculator.h"
 
 using namespace std;
 
+// batch mode: evaluates every line of the input file on a thread pool, writes one result per line to the output
+// file and reports the throughput and latency percentiles
+int runBatch(const char* inputName, const char* outputName, size_t threads)
+{
+    ifstream inFile(inputName);
+    ofstream outFile(outputName);
+    if (!inFile.is_open() || !outFile.is_open())
+    {
+        cout << "The input or output file cannot be opened";
+        return 1;
+    }
+    MyBatchCalculator batch(threads);
+    MyBatchReport report = batch.run(inFile, outFile);
+    report.print(cout);
+    return 0;
+}
+
 int main(int argc, char* argv[])
 {
+    if (argc >= 4 && string(argv[1]) == "--batch")
+    {
+        return runBatch(argv[2], argv[3], (argc > 4) ? strtoul(argv[4], nullptr, 10) : 0);
+    }
+
     if (argc != 2)
     {
         std::cout << "You have to provide one test instance file and output file name to run the test main!\n";
@@ -0,0 +1,368 @@
+#ifndef __MYBATCHCALCULATOR_H__
+#define __MYBATCHCALCULATOR_H__
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <exception>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <string>
+
+#include "MyInfixCalculator.h"
+#include "MyThreadPool.h"
+#include "MyVector.h"
+
+// a histogram of latencies in nanoseconds with 16 buckets per power of two, so a percentile read from it is off by
+// less than 1/16 of the value; recording is a few shifts, and histograms of different threads are merged at the end
+class MyLatencyHistogram
+{
+  private:
+    static const size_t SUB_BUCKETS = 16;
+    static const int SUB_BITS = 4;          // log2(SUB_BUCKETS)
+
+    MyVector<size_t> counts;
+    size_t total;
+    long long largest;
+
+    // values below SUB_BUCKETS get a bucket each; above, bucket (e - SUB_BITS + 1, s) holds the values whose highest
+    // bit is e and whose next SUB_BITS bits are s
+    static size_t bucketOf(long long nanos)
+    {
+        unsigned long long v = (nanos < 0) ? 0 : static_cast<unsigned long long>(nanos);
+        if (v < SUB_BUCKETS)
+        {
+          return static_cast<size_t>(v);
+        }
+        int e = SUB_BITS;
+        while ((v >> (e + 1)) != 0)
+        {
+          ++e;
+        }
+        return (e - SUB_BITS + 1) * SUB_BUCKETS + static_cast<size_t>((v >> (e - SUB_BITS)) & (SUB_BUCKETS - 1));
+    }
+
+    // the largest value falling into bucket k
+    static long long bucketTop(size_t k)
+    {
+        if (k < SUB_BUCKETS)
+        {
+          return static_cast<long long>(k);
+        }
+        int shift = static_cast<int>(k / SUB_BUCKETS) - 1;
+        unsigned long long low = static_cast<unsigned long long>(SUB_BUCKETS + k % SUB_BUCKETS) << shift;
+        return static_cast<long long>(low + ((1ULL << shift) - 1));
+    }
+
+  public:
+
+    MyLatencyHistogram() :
+        counts(64 * SUB_BUCKETS),
+        total{0},
+        largest{0}
+    {
+
+    }
+
+    // counts one latency
+    void record(long long nanos)
+    {
+        ++counts[bucketOf(nanos)];
+        ++total;
+        largest = std::max(largest, nanos);
+    }
+
+    // adds the counts of rhs to this histogram
+    void merge(const MyLatencyHistogram & rhs)
+    {
+        for (size_t k = 0; k < counts.size(); ++k)
+        {
+          counts[k] += rhs.counts[k];
+        }
+        total += rhs.total;
+        largest = std::max(largest, rhs.largest);
+    }
+
+    // returns the number of latencies recorded
+    size_t size() const
+    {
+        return total;
+    }
+
+    // returns the latency (in nanoseconds) that fraction q (0 to 1) of the recorded ones do not exceed
+    long long percentile(double q) const
+    {
+        if (total == 0)
+        {
+          return 0;
+        }
+        size_t rank = static_cast<size_t>(q * total);
+        rank = std::min(std::max<size_t>(rank, 1), total);
+        size_t seen = 0;
+        for (size_t k = 0; k < counts.size(); ++k)
+        {
+          seen += counts[k];
+          if (seen >= rank)
+          {
+            return std::min(bucketTop(k), largest);
+          }
+        }
+        return largest;
+    }
+
+    // returns the largest latency recorded
+    long long max() const
+    {
+        return largest;
+    }
+};
+
+// what MyBatchCalculator::run() did
+struct MyBatchReport
+{
+    size_t expressions;             // lines evaluated
+    size_t chunks;                  // chunks of lines handed to the workers
+    size_t threads;                 // worker threads used
+    double seconds;                 // wall time from the first read to the last write
+    MyLatencyHistogram latency;     // per-expression calculate() time, over all workers
+
+    MyBatchReport() :
+        expressions{0},
+        chunks{0},
+        threads{0},
+        seconds{0.0}
+    {
+
+    }
+
+    // returns the number of expressions evaluated per second
+    double throughput() const
+    {
+        return (seconds > 0.0) ? expressions / seconds : 0.0;
+    }
+
+    // prints the totals, the throughput and the latency percentiles
+    void print(std::ostream & os) const
+    {
+        char line[256];
+        std::snprintf(line, sizeof(line), "%zu expressions in %zu chunks on %zu threads: %.3f s, %.0f expressions/s\n",
+                      expressions, chunks, threads, seconds, throughput());
+        os << line;
+        std::snprintf(line, sizeof(line), "latency (us): p50 %.3f  p90 %.3f  p99 %.3f  p99.9 %.3f  max %.3f\n",
+                      latency.percentile(0.50) / 1000.0, latency.percentile(0.90) / 1000.0,
+                      latency.percentile(0.99) / 1000.0, latency.percentile(0.999) / 1000.0, latency.max() / 1000.0);
+        os << line;
+    }
+};
+
+// evaluates a stream of one-expression-per-line input on a MyThreadPool and writes one result per line, in input order
+// the input is read in chunks of chunkLines lines; at most two chunks per worker are in flight, so memory stays bounded
+// however long the input is; every worker has its own MyInfixCalculator (and so its own compiled-expression cache) and
+// formats its results itself, leaving the reading thread only the reads and the ordered writes
+// programs using this need to be linked with -pthread
+class MyBatchCalculator
+{
+  private:
+    // a chunk of input lines and the formatted results of those lines
+    struct Chunk
+    {
+        MyVector<std::string> lines;
+        size_t count;           // the lines in use
+        MyVector<double> values;    // the results of the lines, before formatting
+        std::string results;
+        bool done;              // guarded by lock
+    };
+
+    size_t numThreads;
+    size_t chunkLines;
+    size_t cacheSize;
+    std::mutex lock;
+    std::condition_variable chunkDone;
+
+    // fills chunk with up to chunkLines lines of in; returns the number read
+    size_t readChunk(std::istream & in, Chunk & chunk)
+    {
+        chunk.count = 0;
+        while (chunk.count < chunkLines && std::getline(in, chunk.lines[chunk.count]))
+        {
+          std::string & line = chunk.lines[chunk.count];
+          if (!line.empty() && line[line.size() - 1] == '\r')
+          {
+            line.erase(line.size() - 1);
+          }
+          ++chunk.count;
+        }
+        return chunk.count;
+    }
+
+    // checks whether every ')' of line closes an earlier '(' and every '(' is closed
+    static bool balanced(const std::string & line)
+    {
+        size_t open = 0;
+        for (size_t k = 0; k < line.size(); ++k)
+        {
+          if (line[k] == '(')
+          {
+            ++open;
+          }
+          else if (line[k] == ')')
+          {
+            if (open == 0)
+            {
+              return false;
+            }
+            --open;
+          }
+        }
+        return open == 0;
+    }
+
+    // evaluates one line on its own: a line with unbalanced parentheses, or one the calculator throws on (such as an
+    // operand std::stod finds out of range), gives NaN instead of ending the batch
+    static double evaluateLine(const std::string & line, MyInfixCalculator & calculator)
+    {
+        if (!balanced(line))
+        {
+          return std::numeric_limits<double>::quiet_NaN();
+        }
+        try
+        {
+          return calculator.calculate(line);
+        }
+        catch (const std::exception &)
+        {
+          return std::numeric_limits<double>::quiet_NaN();
+        }
+    }
+
+    // evaluates a chunk on a worker; runs on the pool
+    void evaluateChunk(Chunk & chunk, MyInfixCalculator & calculator, MyLatencyHistogram & latency)
+    {
+        // the calculations run back to back, so each reading of the clock ends one and starts the next
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (size_t k = 0; k < chunk.count; ++k)
+        {
+          chunk.values[k] = evaluateLine(chunk.lines[k], calculator);
+          std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+          latency.record(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+          start = end;
+        }
+        chunk.results.clear();
+        for (size_t k = 0; k < chunk.count; ++k)
+        {
+          // the same format as the single-expression output: fixed with 3 decimals
+          char buffer[400];
+          int n = std::snprintf(buffer, sizeof(buffer), "%.3f\n", chunk.values[k]);
+          chunk.results.append(buffer, std::min<size_t>(n, sizeof(buffer) - 1));
+        }
+        {
+          std::lock_guard<std::mutex> guard(lock);
+          chunk.done = true;
+        }
+        chunkDone.notify_all();
+    }
+
+    // waits for a chunk to be evaluated and writes its results
+    void writeChunk(std::ostream & out, Chunk & chunk)
+    {
+        {
+          std::unique_lock<std::mutex> guard(lock);
+          while (!chunk.done)
+          {
+            chunkDone.wait(guard);
+          }
+        }
+        out.write(chunk.results.data(), chunk.results.size());
+    }
+
+  public:
+
+    // threads is the number of workers (0: one per hardware thread); chunk is the number of lines handed to a worker
+    // at a time; cache is the compiled-expression cache size of each worker's calculator
+    explicit MyBatchCalculator(size_t threads = 0, size_t chunk = 4096, size_t cache = 256) :
+        numThreads{threads},
+        chunkLines{(chunk == 0) ? 1 : chunk},
+        cacheSize{cache}
+    {
+
+    }
+
+    MyBatchCalculator(const MyBatchCalculator & rhs) = delete;
+    MyBatchCalculator & operator= (const MyBatchCalculator & rhs) = delete;
+
+    // evaluates every line of in, writing the result of each to out in input order
+    MyBatchReport run(std::istream & in, std::ostream & out)
+    {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        MyBatchReport report;
+        MyVector<MyInfixCalculator*> calculators;
+        MyVector<MyLatencyHistogram> latencies;
+        MyVector<Chunk*> window;
+        {
+          MyThreadPool pool(numThreads);
+          report.threads = pool.size();
+          latencies.resize(pool.size());
+          for (size_t k = 0; k < pool.size(); ++k)
+          {
+            calculators.push_back(new MyInfixCalculator(cacheSize));
+          }
+          for (size_t k = 0; k < 2 * pool.size(); ++k)
+          {
+            Chunk *chunk = new Chunk;
+            chunk->lines.resize(chunkLines);
+            chunk->values.resize(chunkLines);
+            chunk->count = 0;
+            chunk->done = true;
+            window.push_back(chunk);
+          }
+          // chunk number c lives in window[c % window.size()]; chunks [written, read) are in flight
+          size_t read = 0;
+          size_t written = 0;
+          while (in)
+          {
+            Chunk & chunk = *window[read % window.size()];
+            if (read - written == window.size())
+            {
+              writeChunk(out, chunk);
+              ++written;
+            }
+            if (readChunk(in, chunk) == 0)
+            {
+              break;
+            }
+            report.expressions += chunk.count;
+            chunk.done = false;
+            Chunk *c = &chunk;
+            pool.submit([this, c, &pool, &calculators, &latencies]()
+                {
+                    int worker = pool.workerId();
+                    evaluateChunk(*c, *calculators[worker], latencies[worker]);
+                });
+            ++read;
+          }
+          for ( ; written < read; ++written)
+          {
+            writeChunk(out, *window[written % window.size()]);
+          }
+          report.chunks = read;
+        }
+        out.flush();
+        for (size_t k = 0; k < calculators.size(); ++k)
+        {
+          report.latency.merge(latencies[k]);
+          delete calculators[k];
+        }
+        for (size_t k = 0; k < window.size(); ++k)
+        {
+          delete window[k];
+        }
+        report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return report;
+    }
+
+};
+
+
+#endif // __MYBATCHCALCULATOR_H__
@@ -0,0 +1,195 @@
+#ifndef __MYCALCULATORSIMD_H__
+#define __MYCALCULATORSIMD_H__
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// the arithmetic behind MyInfixCalculator, on one value at a time and on blocks of rows for batch evaluation
+// every intermediate result is rounded to 6 decimal places, exactly as the string-based evaluation rounded it;
+// the block kernels use AVX2 when the CPU supports it (checked once at run time) and plain loops otherwise,
+// and give bit for bit the same results either way
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#ifndef MY_SIMD_X86
+#define MY_SIMD_X86 1
+#endif
+#include <immintrin.h>
+#endif
+
+// the binary operators of a compiled expression
+enum MyCalcOperator
+{
+    CALC_ADD,
+    CALC_SUBTRACT,
+    CALC_MULTIPLY,
+    CALC_DIVIDE
+};
+
+// rounds x to 6 decimal places, reproducing bit for bit what formatting it with std::to_string and reading it back
+// with std::stod gives; x * 10^6 is taken exactly as p + e and rounded to an integer with ties to even, like printf
+inline double calcRoundToMicros(const double x)
+{
+    double p = x * 1e6;
+    double magnitude = std::fabs(p);
+    if (!(magnitude < 9007199254740992.0))
+    {
+      // from 2^53 up, rounding to 6 decimals moves x by less than half its ulp; also passes inf and nan through
+      return x;
+    }
+    // Dekker's exact product: x is split by clearing its low 27 mantissa bits, and 10^6 has few enough bits
+    // to need no splitting, so every partial product is exact (even if the compiler fuses them into fma)
+    uint64_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    bits &= 0xFFFFFFFFF8000000ULL;
+    double high;
+    std::memcpy(&high, &bits, sizeof(high));
+    double low = x - high;
+    double e = (high * 1e6 - p) + low * 1e6;
+    // below 2^51, adding and subtracting 1.5 * 2^52 rounds p to an integer (ties to even) without a library call
+    double q = (magnitude < 2251799813685248.0) ? (p + 6755399441055744.0) - 6755399441055744.0 : std::nearbyint(p);
+    double up = 0.5 - (p - q);
+    double down = -0.5 - (p - q);
+    bool odd = (static_cast<long long>(q) & 1) != 0;
+    if ((e > up) || (e == up && odd))
+    {
+      q += 1.0;
+    }
+    else if ((e < down) || (e == down && odd))
+    {
+      q -= 1.0;
+    }
+    if (q == 0.0)
+    {
+      // "-0.000000" reads back as -0.0
+      return std::copysign(0.0, x);
+    }
+    return q / 1e6;
+}
+
+// applies op to one pair of operands and rounds the result
+inline double calcApply(const MyCalcOperator op, const double left, const double right)
+{
+    switch (op)
+    {
+      case CALC_ADD:
+        return calcRoundToMicros(left + right);
+      case CALC_SUBTRACT:
+        return calcRoundToMicros(left - right);
+      case CALC_MULTIPLY:
+        return calcRoundToMicros(left * right);
+      default:
+        return calcRoundToMicros(left / right);
+    }
+}
+
+// left[i] = left[i] op right[i], rounded, for n rows
+inline void calcScalarBlock(const MyCalcOperator op, double *left, const double *right, size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+      left[i] = calcApply(op, left[i], right[i]);
+    }
+}
+
+#ifdef MY_SIMD_X86
+
+// checks once whether the running CPU supports AVX2
+inline bool calcHasAvx2()
+{
+    static const bool avx2 = __builtin_cpu_supports("avx2");
+    return avx2;
+}
+
+// calcRoundToMicros on four lanes; comparisons with NaN are false, so NaN lanes take the pass-through branch
+__attribute__((target("avx2")))
+inline __m256d avx2RoundToMicros(__m256d x)
+{
+    const __m256d scale = _mm256_set1_pd(1e6);
+    const __m256d half = _mm256_set1_pd(0.5);
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d signMask = _mm256_set1_pd(-0.0);
+    __m256d p = _mm256_mul_pd(x, scale);
+    __m256d magnitude = _mm256_andnot_pd(signMask, p);
+    __m256d small = _mm256_cmp_pd(magnitude, _mm256_set1_pd(9007199254740992.0), _CMP_LT_OQ);
+    __m256d high = _mm256_and_pd(x, _mm256_castsi256_pd(_mm256_set1_epi64x(static_cast<long long>(0xFFFFFFFFF8000000ULL))));
+    __m256d low = _mm256_sub_pd(x, high);
+    __m256d e = _mm256_add_pd(_mm256_sub_pd(_mm256_mul_pd(high, scale), p), _mm256_mul_pd(low, scale));
+    __m256d q = _mm256_round_pd(p, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m256d d = _mm256_sub_pd(p, q);
+    __m256d up = _mm256_sub_pd(half, d);
+    __m256d down = _mm256_sub_pd(_mm256_sub_pd(_mm256_setzero_pd(), half), d);
+    // q is an integer below 2^53, so q / 2 is exact and has a fraction exactly when q is odd
+    __m256d halfQ = _mm256_mul_pd(q, half);
+    __m256d odd = _mm256_cmp_pd(halfQ, _mm256_round_pd(halfQ, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC), _CMP_NEQ_OQ);
+    __m256d increment = _mm256_or_pd(_mm256_cmp_pd(e, up, _CMP_GT_OQ), _mm256_and_pd(_mm256_cmp_pd(e, up, _CMP_EQ_OQ), odd));
+    __m256d decrement = _mm256_andnot_pd(increment,
+        _mm256_or_pd(_mm256_cmp_pd(e, down, _CMP_LT_OQ), _mm256_and_pd(_mm256_cmp_pd(e, down, _CMP_EQ_OQ), odd)));
+    q = _mm256_sub_pd(_mm256_add_pd(q, _mm256_and_pd(increment, one)), _mm256_and_pd(decrement, one));
+    __m256d r = _mm256_div_pd(q, scale);
+    __m256d zero = _mm256_cmp_pd(q, _mm256_setzero_pd(), _CMP_EQ_OQ);
+    r = _mm256_blendv_pd(r, _mm256_and_pd(x, signMask), zero);
+    return _mm256_blendv_pd(x, r, small);
+}
+
+template <MyCalcOperator Op>
+__attribute__((target("avx2")))
+inline void avx2Block(double *left, const double *right, size_t n)
+{
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+      __m256d a = _mm256_loadu_pd(left + i);
+      __m256d b = _mm256_loadu_pd(right + i);
+      __m256d r;
+      switch (Op)
+      {
+        case CALC_ADD:
+          r = _mm256_add_pd(a, b);
+          break;
+        case CALC_SUBTRACT:
+          r = _mm256_sub_pd(a, b);
+          break;
+        case CALC_MULTIPLY:
+          r = _mm256_mul_pd(a, b);
+          break;
+        default:
+          r = _mm256_div_pd(a, b);
+          break;
+      }
+      _mm256_storeu_pd(left + i, avx2RoundToMicros(r));
+    }
+    calcScalarBlock(Op, left + i, right + i, n - i);
+}
+
+#endif
+
+// left[i] = left[i] op right[i], rounded, for n rows; the vectorized kernel when the CPU has one
+inline void calcBlock(const MyCalcOperator op, double *left, const double *right, size_t n)
+{
+#ifdef MY_SIMD_X86
+    if (calcHasAvx2())
+    {
+      switch (op)
+      {
+        case CALC_ADD:
+          avx2Block<CALC_ADD>(left, right, n);
+          return;
+        case CALC_SUBTRACT:
+          avx2Block<CALC_SUBTRACT>(left, right, n);
+          return;
+        case CALC_MULTIPLY:
+          avx2Block<CALC_MULTIPLY>(left, right, n);
+          return;
+        default:
+          avx2Block<CALC_DIVIDE>(left, right, n);
+          return;
+      }
+    }
+#endif
+    calcScalarBlock(op, left, right, n);
+}
+
+
+#endif // __MYCALCULATORSIMD_H__
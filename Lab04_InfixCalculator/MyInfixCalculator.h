@@ -2,16 +2,91 @@
 #define __MYINFIXCALCULATOR_H__
 
 #include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
 #include <string>
 
+#include "MyCalculatorSimd.h"
+#include "MyLRUCache.h"
+#include "MySmallVector.h"
 #include "MyStack.h"
 #include "MyVector.h"
 
 class MyInfixCalculator{
 
   public:
-    
-    MyInfixCalculator()
+
+    // the kinds of token an expression is made of
+    enum TokenKind
+    {
+        OPERAND,
+        VARIABLE,
+        OPERATOR,
+        LEFT_PARENTHESIS,
+        RIGHT_PARENTHESIS
+    };
+
+    // a token parsed once from the input: operands carry their value, variables their index, everything else its character
+    struct Token
+    {
+        TokenKind kind;
+        char op;            // the operator or parenthesis character; '-' for a negated variable, 0 for other operands
+        double value;       // the value of an operand
+        size_t variable;    // the index of a variable in the variables of its program
+    };
+
+    // per-call token lists and stacks; typical expressions fit in the inline slots without touching the heap
+    typedef MySmallVector<Token, 64> TokenVector;
+    typedef MyStack<char, MySmallVector<char, 32> > OperatorStack;
+
+    // the instructions of a compiled expression
+    enum Opcode
+    {
+        PUSH,       // pushes the next constant
+        ADD,
+        SUBTRACT,
+        MULTIPLY,
+        DIVIDE,
+        UNKNOWN,        // an unrecognized operator; the following byte holds its character
+        LOAD,           // pushes the value of the variable whose index is in the following byte
+        LOAD_NEGATED,   // the same, negated
+        STORE,          // copies the top value into the temporary whose index is in the following byte
+        RECALL          // pushes the temporary whose index is in the following byte
+    };
+
+    // a compiled expression: postfix opcodes plus the constant pool, in the order PUSH consumes the constants
+    // variables are names made of letters, digits and '_' (not starting with a digit), numbered by first appearance
+    struct Program
+    {
+        MyVector<unsigned char> code;
+        MyVector<double> constants;
+        MyVector<std::string> variables;
+        size_t maxDepth;    // the deepest the value stack gets
+        size_t numTemps;    // the temporaries STORE and RECALL use
+        bool valid;         // FALSE if some operator lacks an operand, a ')' has no matching '(', nothing is left to
+                            // return or there are too many variables
+    };
+
+    // the values of programs no deeper than this stay on the stack of evaluate()
+    static const size_t LOCAL_STACK_SIZE = 64;
+
+    // a program may use at most this many variables, and keeps at most this many temporaries, so that an instruction
+    // can name either in a byte
+    static const size_t MAX_VARIABLES = 256;
+    static const size_t MAX_TEMPS = 256;
+
+    // batch evaluation runs each instruction over this many rows at a time
+    static const size_t BATCH_ROWS = 256;
+
+    // cacheSize is the number of compiled expressions calculate() keeps, keyed by their text; 0 turns caching off
+    // optimizing makes compile() run optimize() on what it compiles
+    explicit MyInfixCalculator(const size_t cacheSize = 256, const bool optimizing = true) :
+        cache(cacheSize),
+        caching{cacheSize > 0},
+        optimizingCode{optimizing}
     {
 
     }
@@ -23,16 +98,568 @@ class MyInfixCalculator{
 
     double calculate(const std::string& s)
     {
-      MyVector<std::string> infix;
-      MyVector<std::string> postfix;
-      tokenize(s, infix);
-      infixToPostfix(infix, postfix);
-      double tempValue = calPostfix(postfix);
-      return tempValue;
+      if (!caching)
+      {
+        compile(s, scratch);
+        return evaluate(scratch);
+      }
+      Program *program = cache.find(s);
+      if (program == nullptr)
+      {
+        program = &cache.insert(s, compile(s));
+      }
+      return evaluate(*program);
+    }
+
+    // tokenizes s and converts it to postfix once, so that evaluate() can run it any number of times
+    Program compile(const std::string& s)
+    {
+      Program program;
+      compile(s, program);
+      return program;
+    }
+
+    // compiles s into program, reusing the storage program already has
+    void compile(const std::string& s, Program& program)
+    {
+      TokenVector infix;
+      TokenVector postfix;
+      program.code.clear();
+      program.constants.clear();
+      program.variables.clear();
+      tokenize(s, infix, program.variables);
+      bool balanced = infixToPostfix(infix, postfix);
+      program.maxDepth = 0;
+      program.numTemps = 0;
+      program.valid = balanced && (program.variables.size() <= MAX_VARIABLES);
+      size_t depth = 0;
+      for (size_t i = 0; i < postfix.size(); ++i)
+      {
+        if (postfix[i].kind == OPERAND)
+        {
+          program.code.push_back(PUSH);
+          program.constants.push_back(postfix[i].value);
+          program.maxDepth = std::max(program.maxDepth, ++depth);
+          continue;
+        }
+        if (postfix[i].kind == VARIABLE)
+        {
+          program.code.push_back((postfix[i].op == '-') ? LOAD_NEGATED : LOAD);
+          program.code.push_back(static_cast<unsigned char>(postfix[i].variable));
+          program.maxDepth = std::max(program.maxDepth, ++depth);
+          continue;
+        }
+        switch (postfix[i].op)
+        {
+          case '+':
+            program.code.push_back(ADD);
+            break;
+          case '-':
+            program.code.push_back(SUBTRACT);
+            break;
+          case '*':
+            program.code.push_back(MULTIPLY);
+            break;
+          case '/':
+            program.code.push_back(DIVIDE);
+            break;
+          default:
+            program.code.push_back(UNKNOWN);
+            program.code.push_back(static_cast<unsigned char>(postfix[i].op));
+            break;
+        }
+        if (depth < 2)
+        {
+          program.valid = false;
+        }
+        else
+        {
+          --depth;
+        }
+      }
+      if (depth == 0)
+      {
+        program.valid = false;
+      }
+      if (optimizingCode)
+      {
+        optimize(program);
+      }
+    }
+
+    // rewrites a valid program to compute the same results, bit for bit, with fewer instructions:
+    // - an operator on two constants is folded into one constant
+    // - an expression computed more than once is computed once, kept by STORE and reused by RECALL
+    // - x * 1, 1 * x, x / 1, x - 0 and x + (-0) become x when x is already rounded (an operator result or a constant
+    //   rounding leaves alone); x + 0 stays, as -0 + 0 is +0, and so does the operator on a variable, which rounds it
+    // - values the result does not depend on are dropped
+    // a program with an unrecognized operator is left alone, so it still reports that operator on every evaluation
+    void optimize(Program& program) const
+    {
+      if (!program.valid)
+      {
+        return;
+      }
+      if (program.variables.empty())
+      {
+        foldConstantProgram(program);
+        return;
+      }
+      // rebuild the expression as a DAG, every distinct subexpression being one node
+      NodeVector nodes;
+      IndexVector stack;
+      IndexVector table;
+      size_t slots = 16;
+      while (slots < 2 * program.code.size())
+      {
+        slots *= 2;
+      }
+      table.resize(slots);
+      const double *constant = program.constants.begin();
+      for (const unsigned char *code = program.code.begin(); code != program.code.end(); ++code)
+      {
+        Node node;
+        node.opcode = *code;
+        node.operand = 0;
+        node.constant = 0.0;
+        node.left = 0;
+        node.right = 0;
+        switch (*code)
+        {
+          case PUSH:
+            node.constant = *constant++;
+            break;
+          case LOAD:
+          case LOAD_NEGATED:
+            node.operand = *++code;
+            break;
+          case UNKNOWN:
+          case STORE:
+          case RECALL:
+            return;
+          default:
+          {
+            node.right = stack.back();
+            stack.pop_back();
+            node.left = stack.back();
+            stack.pop_back();
+            size_t simplified = simplify(node, nodes, table);
+            if (simplified != NO_NODE)
+            {
+              stack.push_back(simplified);
+              continue;
+            }
+            break;
+          }
+        }
+        stack.push_back(internNode(node, nodes, table));
+      }
+      emit(stack.back(), nodes, program);
+    }
+
+    // runs a compiled expression; returns NaN for an invalid program or one with variables
+    double evaluate(const Program& program) const
+    {
+      if (!program.variables.empty())
+      {
+        return std::numeric_limits<double>::quiet_NaN();
+      }
+      return evaluate(program, nullptr);
+    }
+
+    // runs a compiled expression on one row of variable values, values[k] being that of program.variables[k]
+    // returns NaN for an invalid program
+    double evaluate(const Program& program, const double *values) const
+    {
+      if (!program.valid)
+      {
+        return std::numeric_limits<double>::quiet_NaN();
+      }
+      if (program.maxDepth + program.numTemps <= LOCAL_STACK_SIZE)
+      {
+        double local[LOCAL_STACK_SIZE];
+        return run(program, values, local);
+      }
+      MyVector<double> spill(program.maxDepth + program.numTemps);
+      return run(program, values, spill.begin());
+    }
+
+    // runs a compiled expression on rows of variable values stored column by column: columns[k][r] is the value of
+    // program.variables[k] in row r; writes the result of row r to out[r], or NaN to every row for an invalid program
+    // each instruction runs over BATCH_ROWS rows at a time, on a value stack holding a block of rows per level
+    void evaluate(const Program& program, const double * const *columns, const size_t rows, double *out) const
+    {
+      if (!program.valid)
+      {
+        std::fill(out, out + rows, std::numeric_limits<double>::quiet_NaN());
+        return;
+      }
+      MyVector<double> blocks((program.maxDepth + program.numTemps) * BATCH_ROWS);
+      for (size_t first = 0; first < rows; first += BATCH_ROWS)
+      {
+        size_t n = (rows - first < BATCH_ROWS) ? rows - first : BATCH_ROWS;
+        const double *result = runBlock(program, columns, first, n, blocks.begin());
+        std::copy(result, result + n, out + first);
+      }
+    }
+
+    // returns the compiled-expression cache (for its size and hit counters)
+    const MyLRUCache<std::string, Program>& compiledCache() const
+    {
+      return cache;
     }
 
   private:
 
+    MyLRUCache<std::string, Program> cache;     // compiled expressions by their text
+    bool caching;                               // FALSE if calculate() compiles every time
+    bool optimizingCode;                        // FALSE if compile() skips optimize()
+    Program scratch;                            // what calculate() compiles into when caching is off
+
+    // a node of the DAG optimize() builds: a constant, a variable, or an operator on two other nodes
+    struct Node
+    {
+        unsigned char opcode;   // PUSH, LOAD, LOAD_NEGATED or an operator
+        unsigned char operand;  // the variable of LOAD and LOAD_NEGATED
+        double constant;        // the value of PUSH
+        size_t left;            // the operands of an operator
+        size_t right;
+    };
+
+    typedef MySmallVector<Node, 64> NodeVector;
+    typedef MySmallVector<size_t, 64> IndexVector;
+
+    static const size_t NO_NODE = static_cast<size_t>(-1);
+
+    static bool isOperator(const unsigned char opcode)
+    {
+        return (opcode >= ADD) && (opcode <= DIVIDE);
+    }
+
+    static bool sameConstant(const double a, const double b)
+    {
+        return std::memcmp(&a, &b, sizeof(double)) == 0;
+    }
+
+    // checks whether node is a constant with exactly the value c (telling 0 from -0)
+    static bool isConstant(const Node& node, const double c)
+    {
+        return (node.opcode == PUSH) && sameConstant(node.constant, c);
+    }
+
+    // checks whether the value of a node is left alone by rounding: operator results are rounded already
+    static bool isRounded(const Node& node)
+    {
+        return isOperator(node.opcode) || ((node.opcode == PUSH) && sameConstant(calcRoundToMicros(node.constant), node.constant));
+    }
+
+    // returns the node an operator node reduces to without computing anything (a folded constant is interned like
+    // any other node), or NO_NODE if it does not reduce
+    size_t simplify(const Node& node, NodeVector& nodes, IndexVector& table) const
+    {
+        const Node & left = nodes[node.left];
+        const Node & right = nodes[node.right];
+        if (left.opcode == PUSH && right.opcode == PUSH)
+        {
+          Node folded = left;
+          folded.constant = calcApply(kernelOperator(node.opcode), left.constant, right.constant);
+          return internNode(folded, nodes, table);
+        }
+        switch (node.opcode)
+        {
+          case ADD:
+            if (isConstant(right, -0.0) && isRounded(left))
+            {
+              return node.left;
+            }
+            if (isConstant(left, -0.0) && isRounded(right))
+            {
+              return node.right;
+            }
+            break;
+          case SUBTRACT:
+            if (isConstant(right, 0.0) && isRounded(left))
+            {
+              return node.left;
+            }
+            break;
+          case MULTIPLY:
+            if (isConstant(right, 1.0) && isRounded(left))
+            {
+              return node.left;
+            }
+            if (isConstant(left, 1.0) && isRounded(right))
+            {
+              return node.right;
+            }
+            break;
+          case DIVIDE:
+            if (isConstant(right, 1.0) && isRounded(left))
+            {
+              return node.left;
+            }
+            break;
+        }
+        return NO_NODE;
+    }
+
+    // folds a valid program without variables into the single constant it computes, which is what building its DAG
+    // would end with, only without building it
+    void foldConstantProgram(Program& program) const
+    {
+        for (const unsigned char *code = program.code.begin(); code != program.code.end(); ++code)
+        {
+          if (*code == UNKNOWN || *code == STORE || *code == RECALL)
+          {
+            return;
+          }
+        }
+        double value = evaluate(program);
+        program.code.clear();
+        program.constants.clear();
+        program.code.push_back(PUSH);
+        program.constants.push_back(value);
+        program.maxDepth = 1;
+        program.numTemps = 0;
+    }
+
+    static size_t hashNode(const Node& node)
+    {
+        unsigned long long bits;
+        std::memcpy(&bits, &node.constant, sizeof(bits));
+        unsigned long long h = node.opcode * 0x9E3779B97F4A7C15ULL;
+        h = (h ^ node.operand ^ bits) * 0xBF58476D1CE4E5B9ULL;
+        h = (h ^ node.left) * 0x94D049BB133111EBULL;
+        h = (h ^ node.right) * 0x9E3779B97F4A7C15ULL;
+        return static_cast<size_t>(h ^ (h >> 29));
+    }
+
+    static bool sameNode(const Node& a, const Node& b)
+    {
+        return a.opcode == b.opcode && a.operand == b.operand && sameConstant(a.constant, b.constant) &&
+               a.left == b.left && a.right == b.right;
+    }
+
+    // returns the node equal to node, adding it if there is none yet; table is a linear-probing index over nodes
+    // (holding a node index plus one), with at least twice as many slots as there are instructions to read
+    size_t internNode(const Node& node, NodeVector& nodes, IndexVector& table) const
+    {
+        size_t mask = table.size() - 1;
+        size_t slot = hashNode(node) & mask;
+        while (table[slot] != 0)
+        {
+          if (sameNode(nodes[table[slot] - 1], node))
+          {
+            return table[slot] - 1;
+          }
+          slot = (slot + 1) & mask;
+        }
+        nodes.push_back(node);
+        table[slot] = nodes.size();
+        return nodes.size() - 1;
+    }
+
+    // replaces the code of program with that computing node root of nodes, left operands first; a node with several
+    // users is computed at its first use and recalled at the others
+    // walks the DAG with explicit stacks, as long expressions make deep ones
+    void emit(const size_t root, const NodeVector& nodes, Program& program) const
+    {
+      // count the users of every node reachable from root
+      IndexVector users;
+      users.resize(nodes.size());
+      MySmallVector<bool, 64> seen;
+      seen.resize(nodes.size());
+      IndexVector work;
+      work.push_back(root);
+      seen[root] = true;
+      while (!work.empty())
+      {
+        const Node & node = nodes[work.back()];
+        work.pop_back();
+        if (!isOperator(node.opcode))
+        {
+          continue;
+        }
+        size_t operands[2] = {node.left, node.right};
+        for (size_t k = 0; k < 2; ++k)
+        {
+          ++users[operands[k]];
+          if (!seen[operands[k]])
+          {
+            seen[operands[k]] = true;
+            work.push_back(operands[k]);
+          }
+        }
+      }
+      program.code.clear();
+      program.constants.clear();
+      program.maxDepth = 0;
+      program.numTemps = 0;
+      // temps[k] is the temporary holding node k plus one, once it is computed; work holds a node index times two,
+      // plus one when its operands are on the stack already
+      IndexVector temps;
+      temps.resize(nodes.size());
+      size_t depth = 0;
+      work.push_back(2 * root);
+      while (!work.empty())
+      {
+        size_t k = work.back() / 2;
+        bool operandsDone = (work.back() % 2) != 0;
+        work.pop_back();
+        const Node & node = nodes[k];
+        if (operandsDone)
+        {
+          program.code.push_back(node.opcode);
+          --depth;
+          if (users[k] > 1 && program.numTemps < MAX_TEMPS)
+          {
+            temps[k] = ++program.numTemps;
+            program.code.push_back(STORE);
+            program.code.push_back(static_cast<unsigned char>(temps[k] - 1));
+          }
+          continue;
+        }
+        if (temps[k] != 0)
+        {
+          program.code.push_back(RECALL);
+          program.code.push_back(static_cast<unsigned char>(temps[k] - 1));
+        }
+        else if (node.opcode == PUSH)
+        {
+          program.code.push_back(PUSH);
+          program.constants.push_back(node.constant);
+        }
+        else if (!isOperator(node.opcode))
+        {
+          program.code.push_back(node.opcode);
+          program.code.push_back(node.operand);
+        }
+        else
+        {
+          work.push_back(2 * k + 1);
+          work.push_back(2 * node.right);
+          work.push_back(2 * node.left);
+          continue;
+        }
+        program.maxDepth = std::max(program.maxDepth, ++depth);
+      }
+    }
+
+    // the kernel operator of ADD, SUBTRACT, MULTIPLY or DIVIDE, which are declared in the same order
+    static MyCalcOperator kernelOperator(const unsigned char opcode)
+    {
+        return static_cast<MyCalcOperator>(opcode - ADD);
+    }
+
+    // runs a valid program on one row of variable values; stack has room for program.maxDepth values followed by
+    // program.numTemps temporaries
+    double run(const Program& program, const double *variables, double *stack) const
+    {
+      double *top = stack;      // one past the top value
+      double *temps = stack + program.maxDepth;
+      const double *constant = program.constants.begin();
+      const unsigned char *code = program.code.begin();
+      const unsigned char *end = program.code.end();
+      for ( ; code != end; ++code)
+      {
+        switch (*code)
+        {
+          case PUSH:
+            *top++ = *constant++;
+            break;
+          case LOAD:
+            *top++ = variables[*++code];
+            break;
+          case LOAD_NEGATED:
+            *top++ = -variables[*++code];
+            break;
+          case STORE:
+            temps[*++code] = top[-1];
+            break;
+          case RECALL:
+            *top++ = temps[*++code];
+            break;
+          case UNKNOWN:
+            --top;
+            top[-1] = calcRoundToMicros(computeBinaryOperation(top[-1], top[0], static_cast<char>(*++code)));
+            break;
+          default:
+            --top;
+            top[-1] = calcApply(kernelOperator(*code), top[-1], top[0]);
+            break;
+        }
+      }
+      return top[-1];
+    }
+
+    // runs a valid program on the n rows from row first on; level d of the value stack is the block of n values at
+    // blocks + d * BATCH_ROWS, and the temporaries follow the deepest level; returns the block holding the results
+    const double* runBlock(const Program& program, const double * const *columns, const size_t first, const size_t n,
+                           double *blocks) const
+    {
+      double *top = blocks;     // the block one past the top level
+      double *temps = blocks + program.maxDepth * BATCH_ROWS;
+      const double *constant = program.constants.begin();
+      const unsigned char *code = program.code.begin();
+      const unsigned char *end = program.code.end();
+      for ( ; code != end; ++code)
+      {
+        switch (*code)
+        {
+          case PUSH:
+            std::fill(top, top + n, *constant++);
+            top += BATCH_ROWS;
+            break;
+          case LOAD:
+          {
+            const double *column = columns[*++code] + first;
+            std::copy(column, column + n, top);
+            top += BATCH_ROWS;
+            break;
+          }
+          case LOAD_NEGATED:
+          {
+            const double *column = columns[*++code] + first;
+            for (size_t r = 0; r < n; ++r)
+            {
+              top[r] = -column[r];
+            }
+            top += BATCH_ROWS;
+            break;
+          }
+          case STORE:
+          {
+            double *temp = temps + *++code * BATCH_ROWS;
+            std::copy(top - BATCH_ROWS, top - BATCH_ROWS + n, temp);
+            break;
+          }
+          case RECALL:
+          {
+            const double *temp = temps + *++code * BATCH_ROWS;
+            std::copy(temp, temp + n, top);
+            top += BATCH_ROWS;
+            break;
+          }
+          case UNKNOWN:
+          {
+            top -= BATCH_ROWS;
+            double *left = top - BATCH_ROWS;
+            char op = static_cast<char>(*++code);
+            for (size_t r = 0; r < n; ++r)
+            {
+              left[r] = calcRoundToMicros(computeBinaryOperation(left[r], top[r], op));
+            }
+            break;
+          }
+          default:
+            top -= BATCH_ROWS;
+            calcBlock(kernelOperator(*code), top - BATCH_ROWS, top, n);
+            break;
+        }
+      }
+      return top - BATCH_ROWS;
+    }
+
     // returns operator precedance; the smaller the number the higher precedence
     // returns -1 if the operator is invalid
     // does not consider parenthesis
@@ -75,12 +702,61 @@ class MyInfixCalculator{
         return false;
     }
 
-    // computes binary operation given the two operands and the operator in their string form
-    double computeBinaryOperation(const std::string& ornd1, const std::string& ornd2, const std::string& opt) const
+    // checks if a character may start / continue a variable name
+    bool isNameStart(const char c) const
+    {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c == '_');
+    }
+
+    bool isNameCharacter(const char c) const
+    {
+        return isNameStart(c) || isDigit(c);
+    }
+
+    // makes the token for an operator or parenthesis character
+    Token operatorToken(const char c) const
     {
-        double o1 = std::stod(ornd1);
-        double o2 = std::stod(ornd2);
-        switch(opt[0])
+        Token token;
+        token.kind = (c == '(') ? LEFT_PARENTHESIS : (c == ')') ? RIGHT_PARENTHESIS : OPERATOR;
+        token.op = c;
+        token.value = 0.0;
+        token.variable = 0;
+        return token;
+    }
+
+    // returns the index of the variable named s[first, last) in variables, adding it if it is new
+    size_t variableIndex(const std::string& s, const size_t first, const size_t last, MyVector<std::string>& variables) const
+    {
+        for (size_t k = 0; k < variables.size(); ++k)
+        {
+          if (s.compare(first, last - first, variables[k]) == 0)
+          {
+            return k;
+          }
+        }
+        variables.push_back(s.substr(first, last - first));
+        return variables.size() - 1;
+    }
+
+    // converts the characters s[first, last) of an operand to its value the way std::stod would,
+    // but through a buffer on the stack instead of a temporary string
+    double parseOperand(const std::string& s, const size_t first, const size_t last) const
+    {
+        char buffer[64];
+        size_t n = last - first;
+        if (n >= sizeof(buffer))
+        {
+          return std::stod(s.substr(first, n));
+        }
+        std::copy(s.begin() + first, s.begin() + last, buffer);
+        buffer[n] = '\0';
+        return std::strtod(buffer, nullptr);
+    }
+
+    // computes binary operation given the two operands and the operator
+    double computeBinaryOperation(const double o1, const double o2, const char opt) const
+    {
+        switch(opt)
         {
             case '+':
                 return o1 + o2;
@@ -97,87 +773,134 @@ class MyInfixCalculator{
     }
 
 
-    // tokenizes an infix string s into a set of tokens (operands or operators)
-    void tokenize(const std::string& s, MyVector<std::string>& tokens)
+    // tokenizes an infix string s into a set of tokens (operands, variables or operators), adding the names of
+    // new variables to variables; blanks only separate tokens
+    // a '-' where an operand is expected is the sign of that operand
+    void tokenize(const std::string& s, TokenVector& tokens, MyVector<std::string>& variables)
     {
         size_t i = 0;
         bool Negative = true;
         while (i < s.length())
         {
-          std::string temp = "";
+          if ((s[i] == ' ') || (s[i] == '\t'))
+          {
+            i++;
+            continue;
+          }
+          size_t first = i;
           if ((s[i] == '-') && Negative)
           {
-            temp += s[i++];
+            i++;
+          }
+          if (isNameStart(s[i]))
+          {
+            size_t name = i;
+            while (isNameCharacter(s[i]))
+            {
+              i++;
+            }
+            Negative = false;
+            Token token;
+            token.kind = VARIABLE;
+            token.op = (name > first) ? '-' : 0;
+            token.value = 0.0;
+            token.variable = variableIndex(s, name, i, variables);
+            tokens.push_back(token);
+            continue;
           }
           while (isDigit(s[i]) || (s[i] == '.'))
           {
-            temp += s[i++];
+            i++;
           }
           Negative = false;
-          if (temp == "") 
+          if (i == first + 1 && s[first] == '-')
+          {
+            // a sign without digits stays an operator
+            tokens.push_back(operatorToken('-'));
+          }
+          else if (i > first)
           {
-            temp += s[i++];
-            if (temp != ")") 
-            {         
+            Token token;
+            token.kind = OPERAND;
+            token.op = 0;
+            token.value = parseOperand(s, first, i);
+            token.variable = 0;
+            tokens.push_back(token);
+          }
+          else
+          {
+            if (s[i] != ')')
+            {
               Negative = true;
-            }  
+            }
+            tokens.push_back(operatorToken(s[i++]));
           }
-          tokens.push_back(temp);
         }
     }
 
     // converts a set of infix tokens to a set of postfix tokens
-    void infixToPostfix(MyVector<std::string>& infix_tokens, MyVector<std::string>& postfix_tokens)
+    // the stack only holds operators and parentheses, so it keeps their characters
+    // returns FALSE, leaving the postfix tokens incomplete, if a ')' has no matching '('
+    bool infixToPostfix(TokenVector& infix_tokens, TokenVector& postfix_tokens)
     {
-      MyStack<std::string> stack;
-      for (int i = 0; i < infix_tokens.size(); ++i)
+      OperatorStack stack;
+      for (size_t i = 0; i < infix_tokens.size(); ++i)
       {
-        if (isDigit(infix_tokens[i][1]) || isDigit(infix_tokens[i][2]))
+        const Token & token = infix_tokens[i];
+        if ((token.kind == OPERAND) || (token.kind == VARIABLE))
         {
-          postfix_tokens.push_back(infix_tokens[i]);
+          postfix_tokens.push_back(token);
         } 
         else
         {
           if (stack.empty())
           {
-            stack.push(infix_tokens[i]);
+            if (token.op == ')')
+            {
+              return false;
+            }
+            stack.push(token.op);
           }
           else 
           {
-            if (infix_tokens[i] == "(" || infix_tokens[i] == ")")
+            if (isValidParenthesis(token.op))
             {
-              if (infix_tokens[i] == "(")
+              if (token.op == '(')
               {
-                stack.push(infix_tokens[i]);
+                stack.push(token.op);
               }
-              if (infix_tokens[i] == ")")
+              if (token.op == ')')
               {
-                while (stack.top() != "(")
+                while (!stack.empty() && stack.top() != '(')
                 {
-                  postfix_tokens.push_back(stack.top());
+                  postfix_tokens.push_back(operatorToken(stack.top()));
                   stack.pop();
                 }
+                if (stack.empty())
+                {
+                  return false;
+                }
                 stack.pop();
               }
             }
             else 
             {
-              if (stack.top() == "(" || stack.top() == ")")
+              if (isValidParenthesis(stack.top()))
               {
-                stack.push(infix_tokens[i]);
+                stack.push(token.op);
               }
               else 
               {
-                while ((operatorPrec(infix_tokens[i][0]) >= operatorPrec(stack.top()[0])) && (operatorPrec(stack.top()[0]) != -1) && (operatorPrec(infix_tokens[i][0]) != 1))
+                while ((operatorPrec(token.op) >= operatorPrec(stack.top())) && (operatorPrec(stack.top()) != -1) && (operatorPrec(token.op) != 1))
                 {
-                  postfix_tokens.push_back(stack.top());
+                  postfix_tokens.push_back(operatorToken(stack.top()));
                   stack.pop();
                   if (stack.empty())
                   {
                     break;
                   }
                 }
-                stack.push(infix_tokens[i]);
+                stack.push(token.op);
               }
             } 
           }
@@ -185,31 +908,10 @@ class MyInfixCalculator{
       }  
       while (!stack.empty())
       {
-        postfix_tokens.push_back(stack.top());
+        postfix_tokens.push_back(operatorToken(stack.top()));
         stack.pop();
       }  
-    }
-
-    // calculates the final result from postfix tokens
-    double calPostfix(const MyVector<std::string>& postfix_tokens) const
-    {
-      MyStack <std::string> stack;
-      for (int i = 0; i < postfix_tokens.size(); ++i)
-      {
-        if (postfix_tokens[i].length() > 1)
-        {
-          stack.push(postfix_tokens[i]);
-        }
-        else 
-        {
-          std::string a = stack.top();
-          stack.pop();
-          std::string b = stack.top();
-          stack.pop();
-          stack.push(std::to_string(computeBinaryOperation(b,a,postfix_tokens[i])));
-        }
-      }
-      return (std::stod(stack.top()));
+      return true;
     }
 };
 
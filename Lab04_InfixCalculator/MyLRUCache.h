@@ -0,0 +1,240 @@
+#ifndef __MYLRUCACHE_H__
+#define __MYLRUCACHE_H__
+
+#include <functional>
+#include <utility>
+
+#include "MyVector.h"
+
+// a map holding at most a fixed number of entries; inserting into a full cache evicts the least recently used entry
+// entries live in one MyVector and are chained by position into a recency list (most recent first); a linear-probing
+// index over the entry positions, kept at most half full, finds a key without walking the list
+template <typename KeyType, typename ValueType, typename Hash = std::hash<KeyType> >
+class MyLRUCache
+{
+  private:
+    static const size_t NONE = static_cast<size_t>(-1);
+
+    struct Entry
+    {
+        KeyType key;
+        ValueType value;
+        size_t hash;    // the full hash of key
+        size_t prev;    // the next more recently used entry, or NONE
+        size_t next;    // the next less recently used entry, or NONE
+    };
+
+    MyVector<Entry> entries;    // grows up to maxEntries; an evicted entry's position is reused right away
+    MyVector<size_t> index;     // the probe table; holds an entry position plus one, or 0 for a free slot
+    size_t mostRecent;
+    size_t leastRecent;
+    size_t maxEntries;
+    size_t numHits;
+    size_t numMisses;
+    size_t numEvictions;
+    Hash hasher;
+
+    size_t mask() const
+    {
+        return index.size() - 1;
+    }
+
+    // returns the probe slot holding key, or the free slot where key would go
+    size_t findSlot(const KeyType & key, const size_t hash) const
+    {
+        size_t slot = hash & mask();
+        while (index[slot] != 0)
+        {
+          const Entry & e = entries[index[slot] - 1];
+          if (e.hash == hash && e.key == key)
+          {
+            break;
+          }
+          slot = (slot + 1) & mask();
+        }
+        return slot;
+    }
+
+    // frees a probe slot, shifting back the later slots of its cluster so every key stays reachable from its home
+    void eraseSlot(size_t hole)
+    {
+        size_t slot = hole;
+        while (true)
+        {
+          slot = (slot + 1) & mask();
+          if (index[slot] == 0)
+          {
+            break;
+          }
+          size_t home = entries[index[slot] - 1].hash & mask();
+          if (((slot - home) & mask()) >= ((slot - hole) & mask()))
+          {
+            index[hole] = index[slot];
+            hole = slot;
+          }
+        }
+        index[hole] = 0;
+    }
+
+    void unlink(const size_t k)
+    {
+        Entry & e = entries[k];
+        if (e.prev != NONE)
+        {
+          entries[e.prev].next = e.next;
+        }
+        else
+        {
+          mostRecent = e.next;
+        }
+        if (e.next != NONE)
+        {
+          entries[e.next].prev = e.prev;
+        }
+        else
+        {
+          leastRecent = e.prev;
+        }
+    }
+
+    void linkFront(const size_t k)
+    {
+        Entry & e = entries[k];
+        e.prev = NONE;
+        e.next = mostRecent;
+        if (mostRecent != NONE)
+        {
+          entries[mostRecent].prev = k;
+        }
+        else
+        {
+          leastRecent = k;
+        }
+        mostRecent = k;
+    }
+
+    // marks entry k as the most recently used
+    void touch(const size_t k)
+    {
+        if (k != mostRecent)
+        {
+          unlink(k);
+          linkFront(k);
+        }
+    }
+
+  public:
+
+    // maxSize is the number of entries kept (at least 1)
+    explicit MyLRUCache(const size_t maxSize = 256) :
+        mostRecent{NONE},
+        leastRecent{NONE},
+        maxEntries{(maxSize == 0) ? 1 : maxSize},
+        numHits{0},
+        numMisses{0},
+        numEvictions{0}
+    {
+        size_t slots = 2;
+        while (slots < 2 * maxEntries)
+        {
+          slots *= 2;
+        }
+        index.resize(slots);
+    }
+
+    // returns the value stored for key and marks it the most recently used, or nullptr if key is not cached
+    // the pointer stays valid until the next insert
+    ValueType* find(const KeyType & key)
+    {
+        size_t slot = findSlot(key, hasher(key));
+        if (index[slot] == 0)
+        {
+          ++numMisses;
+          return nullptr;
+        }
+        ++numHits;
+        size_t k = index[slot] - 1;
+        touch(k);
+        return &entries[k].value;
+    }
+
+    // stores value for key as the most recently used entry, evicting the least recently used one if the cache is full
+    // returns the stored value
+    ValueType& insert(const KeyType & key, ValueType && value)
+    {
+        size_t hash = hasher(key);
+        size_t slot = findSlot(key, hash);
+        size_t k;
+        if (index[slot] != 0)
+        {
+          k = index[slot] - 1;
+          entries[k].value = std::move(value);
+          touch(k);
+          return entries[k].value;
+        }
+        if (entries.size() < maxEntries)
+        {
+          k = entries.size();
+          entries.push_back(Entry{key, std::move(value), hash, NONE, NONE});
+        }
+        else
+        {
+          k = leastRecent;
+          unlink(k);
+          eraseSlot(findSlot(entries[k].key, entries[k].hash));
+          entries[k].key = key;
+          entries[k].value = std::move(value);
+          entries[k].hash = hash;
+          ++numEvictions;
+          // the erase may have shifted the free slot found for key
+          slot = findSlot(key, hash);
+        }
+        index[slot] = k + 1;
+        linkFront(k);
+        return entries[k].value;
+    }
+
+    // removes every entry; the counters are kept
+    void clear()
+    {
+        entries.clear();
+        for (size_t k = 0; k < index.size(); ++k)
+        {
+          index[k] = 0;
+        }
+        mostRecent = NONE;
+        leastRecent = NONE;
+    }
+
+    // returns the number of cached entries
+    size_t size() const
+    {
+        return entries.size();
+    }
+
+    // returns the number of entries the cache keeps
+    size_t capacity() const
+    {
+        return maxEntries;
+    }
+
+    // return how many find() calls found / did not find their key, and how many entries were evicted
+    size_t hits() const
+    {
+        return numHits;
+    }
+
+    size_t misses() const
+    {
+        return numMisses;
+    }
+
+    size_t evictions() const
+    {
+        return numEvictions;
+    }
+
+};
+
+
+#endif // __MYLRUCACHE_H__
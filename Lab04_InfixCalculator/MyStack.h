@@ -6,25 +6,27 @@
 
 #include "MyVector.h"
 
-template <typename DataType>
-class MyStack : private MyVector<DataType>
+// Container supplies the storage; it needs push_back, pop_back, back, empty, size and capacity
+// (e.g. MyVector, or MySmallVector for short-lived stacks)
+template <typename DataType, typename Container = MyVector<DataType> >
+class MyStack : private Container
 {  
   public:
 
     // default constructor
-    explicit MyStack(size_t initSize = 0) : MyVector<DataType>()
+    explicit MyStack(size_t initSize = 0) : Container()
     {
 
     }
 
     // copy constructor
-    MyStack(const MyStack & rhs) : MyVector<DataType>(rhs)
+    MyStack(const MyStack & rhs) : Container(rhs)
     {
 
     }
 
     // move constructor
-    MyStack(MyStack && rhs) : MyVector<DataType>(rhs)
+    MyStack(MyStack && rhs) : Container(rhs)
     {
       
     }
@@ -41,57 +43,57 @@ class MyStack : private MyVector<DataType>
     // copy assignment
     MyStack & operator= (const MyStack & rhs)
     {
-      MyVector<DataType>::operator=(rhs);  
+      Container::operator=(rhs);  
       return *this;      
     }
 
     // move assignment
     MyStack & operator= (MyStack && rhs)
     {
-      MyVector<DataType>::opeartor=(std::move(rhs));  
+      Container::operator=(std::move(rhs));  
       return *this;
     }
 
     // insert x to the stack
     void push(const DataType & x)
     {
-      MyVector<DataType>::push_back(x);          
+      Container::push_back(x);          
     }
 
     // insert x to the stack
     void push(DataType && x)
     {
-      MyVector<DataType>::push_back(std::move(x));          
+      Container::push_back(std::move(x));          
     }
 
     // remove the last element from the stack
     void pop(void)
     {
-      MyVector<DataType>::pop_back();  
+      Container::pop_back();  
     }
 
     // access the last element of the stack
     const DataType & top(void) const
     {
-      return MyVector<DataType>::back();  
+      return Container::back();  
     }
 
     // check if the stack is empty; return TRUE is empty; FALSE otherwise
     bool empty(void) const
     {
-      return MyVector<DataType>::empty();        
+      return Container::empty();        
     }
 
     // access the size of the stack
     size_t size() const
     {
-      return MyVector<DataType>::size(); 
+      return Container::size(); 
     }
 
     // access the capacity of the stack
     size_t capacity(void) const 
     {
-      return MyVector<DataType>::capacity();       
+      return Container::capacity();       
     }
 
 };
@@ -0,0 +1,167 @@
+#ifndef __MYWORKSTEALINGDEQUE_H__
+#define __MYWORKSTEALINGDEQUE_H__
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+#include "MyVector.h"
+
+// the Chase-Lev work-stealing deque: one owner thread pushes and pops at the bottom like a stack, while any number of
+// thief threads steal from the top; only the last data element is contended, so the owner rarely pays for a CAS
+// DataType must be trivially copyable (typically a pointer to a task): a thief may read a slot while the owner is
+// reusing it, in which case the thief's CAS on top fails and it discards what it read
+// programs using this need to be linked with -pthread
+template <typename DataType>
+class MyWorkStealingDeque
+{
+    static_assert(std::is_trivially_copyable<DataType>::value, "work-stealing deque slots are read racily");
+
+  private:
+    // a circular array; position p lives in slot p & (capacity - 1)
+    struct RingArray
+    {
+        size_t capacity;
+        std::atomic<DataType> *slots;
+
+        explicit RingArray(size_t c) :
+            capacity{c},
+            slots{new std::atomic<DataType>[c]}
+        {
+
+        }
+
+        ~RingArray()
+        {
+            delete [] slots;
+        }
+
+        DataType get(long long pos) const
+        {
+            return slots[pos & (capacity - 1)].load(std::memory_order_relaxed);
+        }
+
+        void put(long long pos, DataType x)
+        {
+            slots[pos & (capacity - 1)].store(x, std::memory_order_relaxed);
+        }
+    };
+
+    std::atomic<long long> top;             // the next position thieves steal from
+    char pad0[64 - sizeof(std::atomic<long long>)];
+    std::atomic<long long> bottom;          // the next position the owner pushes to
+    std::atomic<RingArray*> array;
+    MyVector<RingArray*> retired;           // arrays replaced by a resize; thieves may still be reading them
+
+    // doubles the array, copying the live positions [t, b); owner thread only
+    RingArray* grow(RingArray *a, long long t, long long b)
+    {
+        RingArray *bigger = new RingArray(2 * a->capacity);
+        for (long long pos = t; pos < b; ++pos)
+        {
+          bigger->put(pos, a->get(pos));
+        }
+        retired.push_back(a);
+        array.store(bigger, std::memory_order_release);
+        return bigger;
+    }
+
+  public:
+
+    // initCapacity is rounded up to a power of two
+    explicit MyWorkStealingDeque(size_t initCapacity = 64) :
+        top{0},
+        bottom{0}
+    {
+        size_t c = 2;
+        while (c < initCapacity)
+        {
+          c *= 2;
+        }
+        array.store(new RingArray(c), std::memory_order_relaxed);
+    }
+
+    MyWorkStealingDeque(const MyWorkStealingDeque & rhs) = delete;
+    MyWorkStealingDeque & operator= (const MyWorkStealingDeque & rhs) = delete;
+
+    // no other thread may be using the deque
+    ~MyWorkStealingDeque()
+    {
+        delete array.load(std::memory_order_relaxed);
+        for (size_t k = 0; k < retired.size(); ++k)
+        {
+          delete retired[k];
+        }
+    }
+
+    // insert x at the bottom; owner thread only
+    void push(DataType x)
+    {
+        long long b = bottom.load(std::memory_order_relaxed);
+        long long t = top.load(std::memory_order_acquire);
+        RingArray *a = array.load(std::memory_order_relaxed);
+        if (b - t > static_cast<long long>(a->capacity) - 1)
+        {
+          a = grow(a, t, b);
+        }
+        a->put(b, x);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom.store(b + 1, std::memory_order_relaxed);
+    }
+
+    // remove the bottom data element into x; returns false if the deque is empty; owner thread only
+    bool pop(DataType & x)
+    {
+        long long b = bottom.load(std::memory_order_relaxed) - 1;
+        RingArray *a = array.load(std::memory_order_relaxed);
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        long long t = top.load(std::memory_order_relaxed);
+        if (t > b)
+        {
+          bottom.store(b + 1, std::memory_order_relaxed);
+          return false;
+        }
+        x = a->get(b);
+        if (t < b)
+        {
+          return true;
+        }
+        // the last data element: race the thieves for it
+        bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return won;
+    }
+
+    // remove the top data element into x; returns false if the deque is empty or another thread won the race
+    // may be called from any thread
+    bool steal(DataType & x)
+    {
+        long long t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        long long b = bottom.load(std::memory_order_acquire);
+        if (t >= b)
+        {
+          return false;
+        }
+        RingArray *a = array.load(std::memory_order_acquire);
+        x = a->get(t);
+        return top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    }
+
+    // returns the number of data elements; only a snapshot while other threads are active
+    size_t size_approx() const
+    {
+        long long n = bottom.load(std::memory_order_relaxed) - top.load(std::memory_order_relaxed);
+        return (n > 0) ? static_cast<size_t>(n) : 0;
+    }
+
+    bool empty_approx() const
+    {
+        return size_approx() == 0;
+    }
+
+};
+
+
+#endif // __MYWORKSTEALINGDEQUE_H__
@@ -0,0 +1,241 @@
+#ifndef __MYPRIORITYTASKQUEUE_H__
+#define __MYPRIORITYTASKQUEUE_H__
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <utility>
+
+#include "MyBinaryHeap.h"
+#include "MyVector.h"
+
+// queue depth and wait latency of one priority level, as returned by MyPriorityTaskQueue::metrics()
+struct MyTaskLevelMetrics
+{
+    size_t enqueued;            // tasks pushed at this level so far
+    size_t dequeued;            // tasks popped at this level so far
+    size_t depth;               // tasks currently waiting at this level
+    size_t maxDepth;            // the largest depth seen
+    long long totalWaitNanos;   // the summed time popped tasks spent waiting
+    long long maxWaitNanos;     // the longest time a popped task spent waiting
+
+    MyTaskLevelMetrics() :
+        enqueued{0},
+        dequeued{0},
+        depth{0},
+        maxDepth{0},
+        totalWaitNanos{0},
+        maxWaitNanos{0}
+    {
+
+    }
+
+    // the average wait of the popped tasks in microseconds
+    double meanWaitMicros() const
+    {
+        return (dequeued == 0) ? 0.0 : totalWaitNanos / 1000.0 / dequeued;
+    }
+};
+
+// a blocking task queue for a pool of worker threads, ordered by priority level and FIFO within a level
+// levels run from 0 (bulk) to numLevels - 1 (most urgent); pop() always hands out the most urgent waiting task,
+// so urgent work never queues behind bulk work that has not started yet
+// pop_batch() takes several tasks under one lock acquisition; close() releases every blocked worker
+// programs using this need to be linked with -pthread
+template <typename Task = std::function<void()> >
+class MyPriorityTaskQueue
+{
+  private:
+    struct Entry
+    {
+        unsigned int level;
+        unsigned long long sequence;    // the push order, so equal levels come out first-in first-out
+        long long enqueuedAt;           // steady_clock time of the push in nanoseconds
+        Task *task;
+
+        // the heap keeps the greatest entry in front: the higher level, then the earlier push
+        bool operator> (const Entry & rhs) const
+        {
+            return (level != rhs.level) ? level > rhs.level : sequence < rhs.sequence;
+        }
+
+        bool operator< (const Entry & rhs) const
+        {
+            return rhs > *this;
+        }
+    };
+
+    MyBinaryHeap<Entry> heap;
+    MyVector<MyTaskLevelMetrics> levels;
+    unsigned long long nextSequence;
+    bool closed;
+    std::mutex lock;
+    std::condition_variable notEmpty;
+
+    static long long now()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // moves the front task out and updates its level's metrics; the lock must be held
+    Task takeFront(long long time)
+    {
+        Entry e = heap.front();
+        heap.dequeue();
+        MyTaskLevelMetrics & m = levels[e.level];
+        long long wait = time - e.enqueuedAt;
+        ++m.dequeued;
+        --m.depth;
+        m.totalWaitNanos += wait;
+        m.maxWaitNanos = std::max(m.maxWaitNanos, wait);
+        Task task = std::move(*e.task);
+        delete e.task;
+        return task;
+    }
+
+  public:
+
+    // numLevels is the number of priority levels (at least 1)
+    explicit MyPriorityTaskQueue(size_t numLevels = 2) :
+        levels((numLevels == 0) ? 1 : numLevels),
+        nextSequence{0},
+        closed{false}
+    {
+
+    }
+
+    MyPriorityTaskQueue(const MyPriorityTaskQueue & rhs) = delete;
+    MyPriorityTaskQueue & operator= (const MyPriorityTaskQueue & rhs) = delete;
+
+    ~MyPriorityTaskQueue()
+    {
+        while (!heap.empty())
+        {
+          delete heap.front().task;
+          heap.dequeue();
+        }
+    }
+
+    // adds task at the given level (clamped to the most urgent level)
+    // returns false, dropping the task, if the queue is closed
+    bool push(Task task, unsigned int level = 0)
+    {
+        if (level >= levels.size())
+        {
+          level = levels.size() - 1;
+        }
+        Entry e;
+        e.level = level;
+        e.task = new Task(std::move(task));
+        {
+          std::lock_guard<std::mutex> guard(lock);
+          if (closed)
+          {
+            delete e.task;
+            return false;
+          }
+          e.sequence = nextSequence++;
+          e.enqueuedAt = now();
+          heap.enqueue(e);
+          MyTaskLevelMetrics & m = levels[level];
+          ++m.enqueued;
+          m.maxDepth = std::max(m.maxDepth, ++m.depth);
+        }
+        notEmpty.notify_one();
+        return true;
+    }
+
+    // waits for a task and moves the most urgent one into task
+    // returns false once the queue is closed and empty
+    bool pop(Task & task)
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        while (heap.empty() && !closed)
+        {
+          notEmpty.wait(guard);
+        }
+        if (heap.empty())
+        {
+          return false;
+        }
+        task = takeFront(now());
+        return true;
+    }
+
+    // like pop(), but returns false right away instead of waiting
+    bool try_pop(Task & task)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (heap.empty())
+        {
+          return false;
+        }
+        task = takeFront(now());
+        return true;
+    }
+
+    // waits for at least one task, then appends up to maxCount tasks to out, most urgent first, under one lock
+    // returns the number appended; 0 once the queue is closed and empty
+    // maxCount == 0 asks for nothing: returns 0 right away without waiting, which says nothing about the queue
+    size_t pop_batch(MyVector<Task> & out, size_t maxCount)
+    {
+        if (maxCount == 0)
+        {
+          return 0;
+        }
+        std::unique_lock<std::mutex> guard(lock);
+        while (heap.empty() && !closed)
+        {
+          notEmpty.wait(guard);
+        }
+        long long time = now();
+        size_t n = 0;
+        while (n < maxCount && !heap.empty())
+        {
+          out.push_back(takeFront(time));
+          ++n;
+        }
+        return n;
+    }
+
+    // refuses further pushes and wakes every waiting worker; tasks already queued can still be popped
+    void close()
+    {
+        {
+          std::lock_guard<std::mutex> guard(lock);
+          closed = true;
+        }
+        notEmpty.notify_all();
+    }
+
+    // returns the number of waiting tasks
+    size_t size()
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        return heap.size();
+    }
+
+    // returns the number of priority levels
+    size_t numLevels() const
+    {
+        return levels.size();
+    }
+
+    // returns a snapshot of the metrics of one level (clamped to the most urgent level, as in push())
+    MyTaskLevelMetrics metrics(unsigned int level)
+    {
+        if (level >= levels.size())
+        {
+          level = levels.size() - 1;
+        }
+        std::lock_guard<std::mutex> guard(lock);
+        return levels[level];
+    }
+
+};
+
+
+#endif // __MYPRIORITYTASKQUEUE_H__
@@ -0,0 +1,104 @@
+// times MyGraph on a random simple graph of 2000 vertices at average degree d: breadth-first searches from every 200th
+// vertex, then deleting half the edges in random order, then deleting every vertex; prints a degree checksum after
+// the edge deletions so runs against different MyGraph.h versions can be compared
+// only the public MyGraph interface is used, so the same file also builds against older versions of MyGraph.h
+// usage: ./BenchGraph [degree ...]   (default 64 256)
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "MyGraph.h"
+
+using namespace std;
+
+static double millisSince(chrono::steady_clock::time_point start)
+{
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+static void run(size_t numVertices, size_t degree, mt19937 & rng)
+{
+    MyGraph<int, int> graph;
+    vector<VertexIDType> vertices;
+    for (size_t k = 0; k < numVertices; ++k)
+    {
+      vertices.push_back(graph.addVertex(static_cast<int>(k)));
+    }
+    // no multi-edges and no self-loops, as MyGraph assumes
+    vector<bool> present(numVertices * numVertices, false);
+    vector<EdgeIDType> edges;
+    size_t numEdges = numVertices * degree / 2;
+    while (edges.size() < numEdges)
+    {
+      size_t s = rng() % numVertices;
+      size_t t = rng() % numVertices;
+      if (s == t || present[s * numVertices + t])
+      {
+        continue;
+      }
+      present[s * numVertices + t] = present[t * numVertices + s] = true;
+      edges.push_back(graph.addEdge(vertices[s], vertices[t], static_cast<int>(edges.size())));
+    }
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    size_t visited = 0;
+    for (size_t k = 0; k < numVertices; k += 200)
+    {
+      MyVector<VertexIDType> path;
+      graph.breadthFirstSearch(vertices[k], path);
+      visited += path.size();
+    }
+    double bfsMillis = millisSince(start);
+
+    shuffle(edges.begin(), edges.end(), rng);
+    start = chrono::steady_clock::now();
+    for (size_t k = 0; k < edges.size() / 2; ++k)
+    {
+      graph.deleteEdge(edges[k]);
+    }
+    double deleteEdgeMillis = millisSince(start);
+
+    size_t degreeSum = 0;
+    unsigned long long checksum = 0;
+    for (size_t k = 0; k < numVertices; ++k)
+    {
+      size_t d = graph.degree(vertices[k]);
+      degreeSum += d;
+      checksum = checksum * 31 + d;
+    }
+
+    start = chrono::steady_clock::now();
+    for (size_t k = 0; k < numVertices; ++k)
+    {
+      graph.deleteVertex(vertices[k]);
+    }
+    double deleteVertexMillis = millisSince(start);
+
+    printf("d=%-4zu deleteEdge %8.1f ms, deleteVertex %8.1f ms, BFS %7.1f ms (%zu visits); degree sum %zu, "
+           "checksum %llx, %zu edges left\n", degree, deleteEdgeMillis, deleteVertexMillis, bfsMillis, visited,
+           degreeSum, checksum, graph.numEdges());
+}
+
+int main(int argc, char* argv[])
+{
+    vector<size_t> degrees;
+    for (int k = 1; k < argc; ++k)
+    {
+      degrees.push_back(strtoul(argv[k], nullptr, 10));
+    }
+    if (degrees.empty())
+    {
+      degrees.push_back(64);
+      degrees.push_back(256);
+    }
+    mt19937 rng(560);
+    for (size_t k = 0; k < degrees.size(); ++k)
+    {
+      run(2000, degrees[k], rng);
+    }
+    return 0;
+}
@@ -5,7 +5,7 @@
 #include <fstream>
 
 #include "MyVector.h"
-#include "MyLinkedList.h"
+#include "MyIntrusiveList.h"
 #include "MyQueue.h"
 #include "MyStack.h"
 #include "MyHashTable.h"
@@ -75,7 +75,9 @@ class MyGraph
     {
       public:
         // default constructor
-        Edge()
+        Edge() :
+            src_hook(this),
+            tgt_hook(this)
         {
             return;
         }
@@ -85,7 +87,9 @@ class MyGraph
         explicit Edge(const VertexIDType sid, const VertexIDType tid, const EdgeDataType& edge_data) :
             src(sid),
             tgt(tid),
-            data(edge_data)
+            data(edge_data),
+            src_hook(this),
+            tgt_hook(this)
         {
             return;
         }
@@ -95,7 +99,9 @@ class MyGraph
         explicit Edge(const VertexIDType sid, const VertexIDType tid, EdgeDataType && edge_data) :
             src(sid),
             tgt(tid),
-            data(std::move(edge_data))
+            data(std::move(edge_data)),
+            src_hook(this),
+            tgt_hook(this)
         {
             return;
         }
@@ -127,6 +133,10 @@ class MyGraph
         int tag;                // the reserved tag varaible
         EdgeDataType data;      // the property associated with the edge
 
+      private:
+        // the links of the edge on the adjacency lists of its source and target vertex; not copied by assignment
+        MyIntrusiveListHook<Edge> src_hook, tgt_hook;
+
         friend class MyGraph;
 
     };
@@ -150,6 +160,10 @@ class MyGraph
     // destructor
     ~MyGraph()
     {
+        for(size_t i = 0; i < adj_list.size(); ++ i)
+        {
+            delete adj_list[i];
+        }
         for(size_t i = 0; i < vertex_set.size(); ++ i)
         {
             delete vertex_set[i];
@@ -158,11 +172,6 @@ class MyGraph
         {
             delete edge_set[i];
         }
-        for(size_t i = 0; i < adj_list.size(); ++ i)
-        {
-            adj_list[i]->clear();
-            delete adj_list[i];
-        }
         return;
     }
 
@@ -178,7 +187,7 @@ class MyGraph
       aVertex->id = current_vertex_ID;
       aVertex->data = v_data;
       vertex_set.push_back(aVertex);
-      adj_list.push_back(new MyLinkedList<EdgeIDType>);
+      adj_list.push_back(new EdgeList);
       num_vertices++;
       return current_vertex_ID++;
     }
@@ -195,7 +204,7 @@ class MyGraph
       aVertex->id = current_vertex_ID;
       aVertex->data = std::move(v_data);
       vertex_set.push_back(aVertex);
-      adj_list.push_back(new MyLinkedList<EdgeIDType>);
+      adj_list.push_back(new EdgeList);
       num_vertices++;
       return current_vertex_ID++;
     }
@@ -226,8 +235,8 @@ class MyGraph
       HashedObj<VertexIDType, size_t> Sid, Tid;
       if (vertex_map.retrieve(sid, Sid) && vertex_map.retrieve(tid, Tid))
       {
-        adj_list[Sid.value]->push_back(current_edge_ID);
-        adj_list[Tid.value]->push_back(current_edge_ID);
+        adj_list[Sid.value]->push_back(aEdge->src_hook);
+        adj_list[Tid.value]->push_back(aEdge->tgt_hook);
       }
       return current_edge_ID++;
     }
@@ -251,8 +260,8 @@ class MyGraph
       HashedObj<VertexIDType, size_t> Sid, Tid;
       if (vertex_map.retrieve(sid, Sid) && vertex_map.retrieve(tid, Tid))
       {
-        adj_list[Sid.value]->push_back(current_edge_ID);
-        adj_list[Tid.value]->push_back(current_edge_ID);
+        adj_list[Sid.value]->push_back(aEdge->src_hook);
+        adj_list[Tid.value]->push_back(aEdge->tgt_hook);
       }
       return current_edge_ID++;
     }
@@ -275,8 +284,7 @@ class MyGraph
         auto & bucket = adj_list[Sid.value];
         for (auto itr = bucket->begin(); itr != bucket->end(); itr++)
         {
-          size_t index = edgeID2SetPos(*itr);
-          Edge* pEdge = edge_set[index];
+          Edge* pEdge = &*itr;
           if ((pEdge->src == sid) && (pEdge->tgt == tid))
           {
             eid = pEdge->id;
@@ -301,22 +309,16 @@ class MyGraph
 
     // deletes the vertex specified by vid from the graph
     // also delete all edges associated with it
-    // expected time complexity: O(d^2), where d is the average degree of the graph
+    // expected time complexity: O(d), where d is the average degree of the graph
     void deleteVertex(const VertexIDType vid)
     {
       size_t vertexPosition = vertexID2SetPos(vid);
-      Vertex* dVertex = vertex_set[vertexPosition];
       auto & bucket = adj_list[vertexPosition];
-      MyVector<EdgeIDType> dVer;
-      for (auto itr = bucket->begin(); itr != bucket->end(); itr++)
+      // deleteEdge unlinks each edge from this list, so the incident edges are taken from the front
+      while (!bucket->empty())
       {
-        dVer.push_back(*itr);
+        deleteEdge(bucket->front().id);
       }
-      for (int i = 0; i < dVer.size(); ++i)
-      {
-        deleteEdge(dVer[i]);
-      }
-      bucket->clear();
       delete adj_list[vertexPosition];
       vertex_map.remove(vertex_set[vertexPosition]->id);
       delete vertex_set[vertexPosition];
@@ -334,25 +336,18 @@ class MyGraph
     }
 
     // deletes the edge specified by eid from the graph
-    // expected time complexity: O(d), where d is the average degree of the graph
+    // expected time complexity: O(1); the edge is unlinked through its own hooks, without searching the lists
     void deleteEdge(const EdgeIDType eid)
     {
       size_t edgePosition = edgeID2SetPos(eid);
       Edge* dEdge = edge_set[edgePosition];
-      size_t sourceIndex = vertexID2SetPos(dEdge->src);
-      size_t targetIndex = vertexID2SetPos(dEdge->tgt);
-      auto & bucketS = adj_list[sourceIndex];
-      auto & bucketT = adj_list[targetIndex];
-      EdgeIDType Id = edgeSetPos2ID(edgePosition);
-      auto itrS = bucketS->find(bucketS->begin(), bucketS->end(), Id);
-      if (itrS != bucketS->end())
+      if (dEdge->src_hook.linked())
       {
-        bucketS->erase(itrS);
+        adj_list[vertexID2SetPos(dEdge->src)]->erase(dEdge->src_hook);
       }
-      auto itrT = bucketT->find(bucketT->begin(), bucketT->end(), Id);
-      if (itrT != bucketT->end())
+      if (dEdge->tgt_hook.linked())
       {
-        bucketT->erase(itrT);
+        adj_list[vertexID2SetPos(dEdge->tgt)]->erase(dEdge->tgt_hook);
       }
        edge_map.remove(eid); 
        delete dEdge;
@@ -395,11 +390,10 @@ class MyGraph
         auto & bucket = adj_list[index];
         for (auto itr = bucket->begin(); itr != bucket->end(); itr++)
         {
-          size_t eIndex = edgeID2SetPos(*itr);
-          VertexIDType nVertex = edge_set[eIndex]->src;
+          VertexIDType nVertex = itr->src;
           if (nVertex == newVertex->id)
           {
-            nVertex = edge_set[eIndex]->tgt;
+            nVertex = itr->tgt;
           }
           vIndex = vertexID2SetPos(nVertex);
           if (vertex_set[vIndex]->tag == 0)
@@ -437,11 +431,10 @@ class MyGraph
         auto & bucket = adj_list[vIndex];
         for (auto itr = bucket->begin(); itr != bucket->end(); itr++)
         {
-          size_t eIndex = edgeID2SetPos(*itr);
-          VertexIDType nVertex = edge_set[eIndex]->src;
+          VertexIDType nVertex = itr->src;
           if (nVertex == newVertex->id)
           {
-            nVertex = edge_set[eIndex]->tgt;
+            nVertex = itr->tgt;
           }   
           dStack.push(vertex_set[vertexID2SetPos(nVertex)]);
         }
@@ -474,11 +467,10 @@ class MyGraph
         auto & bucket = adj_list[vIndex];
         for (auto itr = bucket->begin(); itr != bucket->end(); itr++)
         {
-          size_t eIndex = edgeID2SetPos(*itr);
-          VertexIDType nVertex = edge_set[eIndex]->src;
+          VertexIDType nVertex = itr->src;
           if (nVertex == newVertex->id)
           {
-            nVertex = edge_set[eIndex]->tgt;
+            nVertex = itr->tgt;
           }
           if (nVertex == vid2)
           {
@@ -566,10 +558,10 @@ class MyGraph
             std::cout << "Vertex: " << vertex_set[i]->id << " degree: " << degree(vertex_set[i]->id) << "\tIt is connected with: ";
             for(auto itr = adj_list[i]->begin(); itr != adj_list[i]->end(); ++ itr)
             {
-                if(vertex_set[i]->id == getEdge(*itr)->src)
-                    std::cout << getEdge(*itr)->tgt << "\t";
-                else if(vertex_set[i]->id == getEdge(*itr)->tgt)
-                    std::cout << getEdge(*itr)->src << "\t";
+                if(vertex_set[i]->id == itr->src)
+                    std::cout << itr->tgt << "\t";
+                else if(vertex_set[i]->id == itr->tgt)
+                    std::cout << itr->src << "\t";
                 else
                     throw std::domain_error("MyGraph::printAdjList: edge information may have been corrupted.");
             }
@@ -578,6 +570,8 @@ class MyGraph
     }
 
   private:
+    typedef MyIntrusiveList<Edge> EdgeList;
+
     VertexIDType current_vertex_ID;                 // the ID to be assigned to the next vertex (ID are assigned based on the order of insertion)
     EdgeIDType current_edge_ID;                     // the ID to be assigned to the next edge (IDs are assigned based on the order of insertion)
     size_t num_vertices;                            // the number of vertices
@@ -586,7 +580,7 @@ class MyGraph
     MyVector<Edge*> edge_set;                       // the set of edges
     MyHashTable<VertexIDType, size_t> vertex_map;   // the mapping between a vertex ID and its index in vertex_set
     MyHashTable<EdgeIDType, size_t> edge_map;       // the mapping between an edge ID and its index in vertex_set
-    MyVector<MyLinkedList<EdgeIDType>* > adj_list;  // the adjacency list (stores the IDs for the corresponding edges)
+    MyVector<EdgeList*> adj_list;                   // the adjacency list (threads the incident edges through their hooks)
 
     // maps the vertex ID to its position in the vertex_set array
     size_t vertexID2SetPos(const VertexIDType vid)
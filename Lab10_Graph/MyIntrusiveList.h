@@ -0,0 +1,249 @@
+#ifndef __MYINTRUSIVELIST_H__
+#define __MYINTRUSIVELIST_H__
+
+#include <cstddef>
+
+// the links an object embeds for each intrusive list it may be on; owner points back at the embedding object
+// an object on several lists at once (e.g. an edge on the lists of both its end vertices) embeds one hook per list
+// copying a hook yields an unlinked hook, and assigning leaves the target's links alone, so the owner can still be
+// copied and assigned freely
+template <typename DataType>
+struct MyIntrusiveListHook
+{
+    MyIntrusiveListHook *prev;
+    MyIntrusiveListHook *next;
+    DataType *owner;
+
+    explicit MyIntrusiveListHook(DataType *o = nullptr) :
+        prev{nullptr},
+        next{nullptr},
+        owner{o}
+    {
+
+    }
+
+    MyIntrusiveListHook(const MyIntrusiveListHook &) :
+        prev{nullptr},
+        next{nullptr},
+        owner{nullptr}
+    {
+
+    }
+
+    MyIntrusiveListHook & operator= (const MyIntrusiveListHook &)
+    {
+        return *this;
+    }
+
+    // checks whether the hook is currently on a list
+    bool linked() const
+    {
+        return next != nullptr;
+    }
+};
+
+// a doubly linked list threading objects through hooks embedded in them instead of allocating a node per data element
+// the list never owns, copies or frees its data elements: insertion and removal are pointer updates only, and a data
+// element is removed in O(1) through its hook, without searching the list
+// a data element must be erased before it is destroyed; destroying the list unlinks whatever is still on it
+template <typename DataType>
+class MyIntrusiveList
+{
+  public:
+    typedef MyIntrusiveListHook<DataType> Hook;
+
+  private:
+    Hook sentinel;      // the head and tail of the circular list; holds no data element
+    size_t theSize;     // the number of data elements on the list
+
+    // links hook in front of pos
+    void link(Hook *pos, Hook & hook)
+    {
+        hook.prev = pos->prev;
+        hook.next = pos;
+        pos->prev->next = &hook;
+        pos->prev = &hook;
+        ++theSize;
+    }
+
+  public:
+
+    class iterator
+    {
+      private:
+        Hook *current;
+
+        friend class MyIntrusiveList<DataType>;
+
+      public:
+        explicit iterator(Hook *h = nullptr) :
+            current{h}
+        {
+
+        }
+
+        DataType& operator* () const
+        {
+            return *current->owner;
+        }
+
+        DataType* operator-> () const
+        {
+            return current->owner;
+        }
+
+        // the hook through which the data element is on the list
+        Hook& hook() const
+        {
+            return *current;
+        }
+
+        iterator& operator++ ()
+        {
+            current = current->next;
+            return *this;
+        }
+
+        iterator operator++ (int)
+        {
+            iterator old = *this;
+            ++(*this);
+            return old;
+        }
+
+        iterator& operator-- ()
+        {
+            current = current->prev;
+            return *this;
+        }
+
+        iterator operator-- (int)
+        {
+            iterator old = *this;
+            --(*this);
+            return old;
+        }
+
+        bool operator== (const iterator & rhs) const
+        {
+            return current == rhs.current;
+        }
+
+        bool operator!= (const iterator & rhs) const
+        {
+            return !(*this == rhs);
+        }
+    };
+
+    // default constructor
+    MyIntrusiveList() :
+        theSize{0}
+    {
+        sentinel.prev = &sentinel;
+        sentinel.next = &sentinel;
+    }
+
+    // the hooks point at the sentinel, so a list can be neither copied nor moved; keep it behind a pointer instead
+    MyIntrusiveList(const MyIntrusiveList & rhs) = delete;
+    MyIntrusiveList & operator= (const MyIntrusiveList & rhs) = delete;
+
+    // destructor; unlinks the remaining data elements
+    ~MyIntrusiveList()
+    {
+        clear();
+    }
+
+    iterator begin()
+    {
+        return iterator(sentinel.next);
+    }
+
+    iterator end()
+    {
+        return iterator(&sentinel);
+    }
+
+    // returns the number of data elements on the list
+    size_t size() const
+    {
+        return theSize;
+    }
+
+    // checks whether the list is empty
+    bool empty() const
+    {
+        return theSize == 0;
+    }
+
+    // access the first / last data element
+    DataType& front()
+    {
+        return *sentinel.next->owner;
+    }
+
+    DataType& back()
+    {
+        return *sentinel.prev->owner;
+    }
+
+    // links the data element owning hook in front of pos; hook must not be on any list
+    // returns the position of the inserted data element
+    iterator insert(iterator pos, Hook & hook)
+    {
+        link(pos.current, hook);
+        return iterator(&hook);
+    }
+
+    // links the data element owning hook at the back / front of the list
+    void push_back(Hook & hook)
+    {
+        link(&sentinel, hook);
+    }
+
+    void push_front(Hook & hook)
+    {
+        link(sentinel.next, hook);
+    }
+
+    // unlinks the data element owning hook, which must be on this list
+    // returns the position of the data element that followed it
+    iterator erase(Hook & hook)
+    {
+        Hook *next = hook.next;
+        hook.prev->next = next;
+        next->prev = hook.prev;
+        hook.prev = nullptr;
+        hook.next = nullptr;
+        --theSize;
+        return iterator(next);
+    }
+
+    iterator erase(iterator itr)
+    {
+        return erase(*itr.current);
+    }
+
+    // unlinks the first / last data element
+    void pop_front()
+    {
+        erase(*sentinel.next);
+    }
+
+    void pop_back()
+    {
+        erase(*sentinel.prev);
+    }
+
+    // unlinks every data element
+    void clear()
+    {
+        while (!empty())
+        {
+          pop_front();
+        }
+    }
+
+};
+
+
+#endif // __MYINTRUSIVELIST_H__
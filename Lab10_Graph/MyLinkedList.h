@@ -2,7 +2,14 @@
 #define _MY_LINKEDLIST_H_
 
 #include <algorithm>
+#include <cstddef>
 #include <iostream>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "MyNodePool.h"
 
 template <typename DataType>
 class MyLinkedList
@@ -32,11 +39,89 @@ class MyLinkedList
     Node *head;         // pointer to the head node; does not hold real data
     Node *tail;         // pointer to the tail note; does not hold real data
 
+    // nodes live in the node pool of the calling thread instead of being new'ed one by one
+    typedef MyNodePool<Node> NodePool;
+
+    template <typename... Args>
+    static Node* createNode(Args&&... args)
+    {
+        return new (NodePool::local().allocate()) Node(std::forward<Args>(args)...);
+    }
+
+    static void destroyNode(Node *p)
+    {
+        if (p != nullptr)
+        {
+          p->~Node();
+          NodePool::local().deallocate(p);
+        }
+    }
+
+    // unlinks the nodes [first, last) from their list and links them in front of pos; sizes are left to the caller
+    static void transfer(Node *pos, Node *first, Node *last)
+    {
+        Node *lastKept = last->prev;
+        first->prev->next = last;
+        last->prev = first->prev;
+        first->prev = pos->prev;
+        pos->prev->next = first;
+        lastKept->next = pos;
+        pos->prev = lastKept;
+    }
+
+    // builds detached nodes holding copies of [first, last), linked to each other in order; returns how many
+    // a forward range is counted first, so that all of its nodes come from one contiguous run of the node pool;
+    // when the pool already has enough freed slots, those are reused instead and the pool does not grow
+    template <typename ForwardIterator>
+    static int createChain(ForwardIterator first, ForwardIterator last, Node *& chainFirst, Node *& chainLast,
+                           std::forward_iterator_tag)
+    {
+        size_t n = std::distance(first, last);
+        if (n == 0)
+        {
+          return 0;
+        }
+        if (NodePool::local().hasFreeSlots(n))
+        {
+          return createChain(first, last, chainFirst, chainLast, std::input_iterator_tag());
+        }
+        Node *run = static_cast<Node*>(NodePool::local().allocateRun(n));
+        for (size_t k = 0; k < n; ++k, ++first)
+        {
+          new (run + k) Node(*first, (k == 0) ? nullptr : run + k - 1, run + k + 1);
+        }
+        chainFirst = run;
+        chainLast = run + n - 1;
+        return n;
+    }
+
+    // a single-pass range cannot be counted up front, so its nodes are allocated one by one
+    template <typename InputIterator>
+    static int createChain(InputIterator first, InputIterator last, Node *& chainFirst, Node *& chainLast,
+                           std::input_iterator_tag)
+    {
+        int n = 0;
+        for ( ; first != last; ++first, ++n)
+        {
+          Node *p = createNode(*first, (n == 0) ? nullptr : chainLast, nullptr);
+          if (n == 0)
+          {
+            chainFirst = p;
+          }
+          else
+          {
+            chainLast->next = p;
+          }
+          chainLast = p;
+        }
+        return n;
+    }
+
     void init( )
     { 
         theSize = 0;
-        head = new Node;
-        tail = new Node;
+        head = createNode();
+        tail = createNode();
         head->next = tail;
         tail->prev = head;
     }
@@ -63,6 +148,12 @@ class MyLinkedList
         friend class MyLinkedList<DataType>;
 
       public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef DataType value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const DataType* pointer;
+        typedef const DataType& reference;
+
         const_iterator() : 
         current{nullptr} 
         {}
@@ -132,6 +223,9 @@ class MyLinkedList
         friend class MyLinkedList<DataType>;
       
       public:
+        typedef DataType* pointer;
+        typedef DataType& reference;
+
         // default constructor
         iterator()
         {}
@@ -186,14 +280,20 @@ class MyLinkedList
         init(); 
     }
   
+    // range constructor; builds the list from copies of [first, last)
+    template <typename InputIterator,
+              typename = typename std::enable_if<!std::is_integral<InputIterator>::value>::type>
+    MyLinkedList(InputIterator first, InputIterator last)
+    {
+        init();
+        insert(end(), first, last);
+    }
+
     // copy constructor
     MyLinkedList(const MyLinkedList& rhs)
     { 
         init();
-        for (auto & x : rhs)
-        {
-          push_back(x);
-        }
+        insert(end(), rhs.begin(), rhs.end());
     }
 
     // move constructor
@@ -211,8 +311,8 @@ class MyLinkedList
     ~MyLinkedList()
     {
         clear();
-        delete head;
-        delete tail;
+        destroyNode(head);
+        destroyNode(tail);
     }
 
     // copy assignment
@@ -303,7 +403,7 @@ class MyLinkedList
     {
         Node *p = itr.current;
         theSize++;
-        return {p->prev = p->prev->next = new Node{x,p->prev,p} };
+        return {p->prev = p->prev->next = createNode(x, p->prev, p) };
     }
 
     // insert x before itr; return iterator pointing to the newly inserted data element
@@ -311,7 +411,39 @@ class MyLinkedList
     {
         Node *p = itr.current;
         theSize++;
-        return {p->prev = p->prev->next = new Node{std::move(x),p->prev,p} };
+        return {p->prev = p->prev->next = createNode(std::move(x), p->prev, p) };
+    }
+
+    // insert copies of [first, last) before itr, linking them in with one pass; return iterator pointing to the first
+    // inserted data element, or itr if the range is empty; the range must not point into this list
+    template <typename InputIterator,
+              typename = typename std::enable_if<!std::is_integral<InputIterator>::value>::type>
+    iterator insert(iterator itr, InputIterator first, InputIterator last)
+    {
+        Node *p = itr.current;
+        Node *chainFirst = nullptr;
+        Node *chainLast = nullptr;
+        int n = createChain(first, last, chainFirst, chainLast,
+                            typename std::iterator_traits<InputIterator>::iterator_category());
+        if (n == 0)
+        {
+          return itr;
+        }
+        chainFirst->prev = p->prev;
+        chainLast->next = p;
+        p->prev->next = chainFirst;
+        p->prev = chainLast;
+        theSize += n;
+        return {chainFirst};
+    }
+
+    // replace the data elements with copies of [first, last); the range must not point into this list
+    template <typename InputIterator,
+              typename = typename std::enable_if<!std::is_integral<InputIterator>::value>::type>
+    void assign(InputIterator first, InputIterator last)
+    {
+        clear();
+        insert(end(), first, last);
     }
 
     // delete the data element pointed by itr; return the iterator pointing to the data element next to the one being deleted
@@ -321,7 +453,7 @@ class MyLinkedList
         iterator retVal{p->next};
         p->prev->next = p->next;
         p->next->prev = p->prev;
-        delete p;
+        destroyNode(p);
         theSize--;
         return retVal;
     }
@@ -385,30 +517,55 @@ class MyLinkedList
         erase(--end());
     }
     
-    // reverse the entire linked list
+    // move all data elements of other in front of pos without copying them; other is left empty
+    // O(1): only the nodes at the two ends are relinked
+    void splice(iterator pos, MyLinkedList<DataType>& other)
+    {
+      if (other.empty() || &other == this)
+      {
+        return;
+      }
+      transfer(pos.current, other.head->next, other.tail);
+      theSize += other.theSize;
+      other.theSize = 0;
+    }
+
+    // move the data elements from iterator "first" (inclusive) to iterator "last" (exclusive) of other in front of pos
+    // pos must not lie inside the range; relinking is O(1), but moving between two lists counts the range to keep both sizes
+    void splice(iterator pos, MyLinkedList<DataType>& other, iterator first, iterator last)
+    {
+      if (first == last)
+      {
+        return;
+      }
+      if (&other != this)
+      {
+        int count = 0;
+        for (iterator itr = first; itr != last; ++itr)
+        {
+          ++count;
+        }
+        other.theSize -= count;
+        theSize += count;
+      }
+      transfer(pos.current, first.current, last.current);
+    }
+
+    // reverse the entire linked list in place: every node, head and tail included, swaps its prev and next
+    // pointers, and head and tail swap roles; no node is allocated or copied
     void reverseList()
     {
-      MyLinkedList<DataType> reverse;
-      iterator temp = this->begin();
-      while (this->empty() != true)
+      for (Node *p = head; p != nullptr; p = p->prev)
       {
-        reverse.push_front(*temp);
-        this->pop_front();
-        temp = this->begin();
+        std::swap(p->prev, p->next);
       }
-      *this = reverse;
+      std::swap(head, tail);
     }
  
-    // append a linked list to the end of the current one
+    // append a linked list to the end of the current one in O(1); rlist is left empty
     MyLinkedList<DataType>& appendList(MyLinkedList<DataType>&& rlist) 
     {
-      iterator temp = rlist.begin();
-      while (rlist.empty() != true)
-      {
-        this->push_back(*temp);
-        rlist.pop_front();
-        temp = rlist.begin();
-      }
+      splice(end(), rlist);
       return *this;
     }
 
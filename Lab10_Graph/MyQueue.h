@@ -3,168 +3,370 @@
 
 #include <iostream>
 #include <algorithm>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 #include "MyVector.h"
 
+// the tag selecting MyQueue's own ring buffer as its storage
+struct MyQueueRing
+{
+
+};
+
+// a FIFO queue; by default it keeps the data elements in its own ring buffer (the specialization below)
+// any other Container supplies the storage instead; it needs emplace_back, pop_front, front, empty, size and capacity
+// (e.g. MyDeque, which never relocates data elements as the queue grows)
+template <typename DataType, typename Container = MyQueueRing>
+class MyQueue : private Container
+{
+  public:
+
+    // default constructor
+    MyQueue() : Container()
+    {
+
+    }
+
+    // copy constructor
+    MyQueue(const MyQueue & rhs) : Container(rhs)
+    {
+
+    }
+
+    // move constructor
+    MyQueue(MyQueue && rhs) : Container(std::move(rhs))
+    {
+
+    }
+
+    // copy assignment
+    MyQueue & operator= (const MyQueue & rhs)
+    {
+        Container::operator=(rhs);
+        return *this;
+    }
+
+    // move assignment
+    MyQueue & operator= (MyQueue && rhs)
+    {
+        Container::operator=(std::move(rhs));
+        return *this;
+    }
+
+    // construct a data element in place at the back of the queue
+    template <typename... Args>
+    void emplace(Args&&... args)
+    {
+        Container::emplace_back(std::forward<Args>(args)...);
+    }
+
+    // insert x into the queue
+    void enqueue(const DataType & x)
+    {
+        emplace(x);
+    }
+
+    void enqueue(DataType && x)
+    {
+        emplace(std::move(x));
+    }
+
+    // insert copies of the data elements [first, last) into the queue
+    void enqueue_range(const DataType *first, const DataType *last)
+    {
+        for (; first != last; ++first)
+        {
+          emplace(*first);
+        }
+    }
+
+    // remove the first element from the queue
+    void dequeue(void)
+    {
+        Container::pop_front();
+    }
+
+    // move up to n data elements from the front of the queue into out; returns how many were moved
+    size_t dequeue_range(DataType *out, size_t n)
+    {
+        n = std::min(n, size());
+        for (size_t k = 0; k < n; ++k)
+        {
+          out[k] = std::move(front());
+          dequeue();
+        }
+        return n;
+    }
+
+    // access the first element of the queue
+    DataType & front(void)
+    {
+        return Container::front();
+    }
+
+    const DataType & front(void) const
+    {
+        return Container::front();
+    }
+
+    // check if the queue is empty; return TRUE is empty; FALSE otherwise
+    bool empty(void) const
+    {
+        return Container::empty();
+    }
+
+    // access the size of the queue
+    size_t size() const
+    {
+        return Container::size();
+    }
+
+    // access the capacity of the queue
+    size_t capacity(void) const
+    {
+        return Container::capacity();
+    }
+
+};
+
+// the default queue, on a ring buffer whose capacity is always a power of two
+// head and tail count every dequeue and enqueue ever made and are only masked when a slot is accessed,
+// so size() is tail - head and wrapping around needs no branches
 template <typename DataType>
-class MyQueue : private MyVector<DataType>
-{  
+class MyQueue<DataType, MyQueueRing>
+{
   private:
-    size_t dataStart, dataEnd;
+    typedef typename std::aligned_storage<sizeof(DataType), alignof(DataType)>::type Slot;
+
+    Slot *ring;             // the slots; only slots in [head, tail) hold data elements, the rest are raw storage
+    size_t numSlots;        // the capacity; a power of two, or 0 once the queue has been moved from
+    size_t head;            // the number of dequeues so far; the front lives in slot head & mask()
+    size_t tail;            // the number of enqueues so far; the next data element goes into slot tail & mask()
 
-    // changes the size of the array to newSize
-    void resize(size_t newSize)
+    size_t mask() const
     {
-        MyVector<DataType>::resize(newSize);
+        return numSlots - 1;
     }
 
-    // requests for newCapacity amount of space
-    void reserve(size_t newCapacity)
+    // allocates n slots without initializing them
+    static Slot* allocateSlots(size_t n)
+    {
+        return std::allocator<Slot>().allocate(n);
+    }
+
+    static void deallocateSlots(Slot *p, size_t n)
+    {
+        if (p != nullptr)
+        {
+          std::allocator<Slot>().deallocate(p, n);
+        }
+    }
+
+    DataType* at(size_t pos)
+    {
+        return reinterpret_cast<DataType*>(&ring[pos & mask()]);
+    }
+
+    const DataType* at(size_t pos) const
     {
-        size_t tempReserve = capacity();
-        MyVector<DataType>::reserveQueue(newCapacity, dataStart, dataEnd);
-        dataStart = 0;
-        dataEnd = (tempReserve - 2);
+        return reinterpret_cast<const DataType*>(&ring[pos & mask()]);
+    }
+
+    // the smallest power-of-two capacity holding n data elements
+    static size_t capacityFor(size_t n)
+    {
+        size_t c = MyVector<DataType>::SPARE_CAPACITY;
+        while (c < n)
+        {
+          c *= 2;
+        }
+        return c;
+    }
+
+    // moves the data elements in order into the front of bigger (biggerSlots slots), which becomes the ring
+    void adopt(Slot *bigger, size_t biggerSlots)
+    {
+        DataType *dst = reinterpret_cast<DataType*>(bigger);
+        for (size_t pos = head; pos != tail; ++pos)
+        {
+          new (dst + (pos - head)) DataType(std::move(*at(pos)));
+          at(pos)->~DataType();
+        }
+        tail -= head;
+        head = 0;
+        deallocateSlots(ring, numSlots);
+        ring = bigger;
+        numSlots = biggerSlots;
     }
 
   public:
 
-    // default constructor
-    explicit MyQueue(size_t initSize = 0) : MyVector<DataType>(initSize)
+    // default constructor; initSize is the number of data elements to make room for
+    explicit MyQueue(size_t initSize = 0) :
+        ring{allocateSlots(capacityFor(initSize))},
+        numSlots{capacityFor(initSize)},
+        head{0},
+        tail{0}
     {
-        dataStart = 0;
-        dataEnd = (capacity() - 1);
+
     }
 
     // copy constructor
-    MyQueue(const MyQueue & rhs) : 
-    MyVector<DataType>(rhs),
-    dataStart{rhs.dataStart},
-    dataEnd{rhs.dataEnd}
+    MyQueue(const MyQueue & rhs) :
+        ring{allocateSlots(capacityFor(rhs.size()))},
+        numSlots{capacityFor(rhs.size())},
+        head{0},
+        tail{0}
     {
-        
+        for (size_t pos = rhs.head; pos != rhs.tail; ++pos)
+        {
+          new (at(tail++)) DataType(*rhs.at(pos));
+        }
     }
 
-    // move constructor
+    // move constructor; rhs is left with no storage and allocates again on its next enqueue
     MyQueue(MyQueue && rhs) :
-    MyVector<DataType>(rhs),
-    dataStart{rhs.dataStart},
-    dataEnd{rhs.dataEnd}
+        ring{rhs.ring},
+        numSlots{rhs.numSlots},
+        head{rhs.head},
+        tail{rhs.tail}
     {
-        rhs.dataStart = 0;
-        rhs.dataEnd = rhs.capacity() - 1;
+        rhs.ring = nullptr;
+        rhs.numSlots = 0;
+        rhs.head = 0;
+        rhs.tail = 0;
     }
 
     // destructor
     ~MyQueue()
     {
-
+        while (!empty())
+        {
+          dequeue();
+        }
+        deallocateSlots(ring, numSlots);
     }
 
     // copy assignment
     MyQueue & operator= (const MyQueue & rhs)
     {
-        MyVector<DataType>::operator=(rhs);
+        MyQueue copy = rhs;
+        std::swap(*this, copy);
         return *this;
     }
 
     // move assignment
     MyQueue & operator= (MyQueue && rhs)
     {
-        MyVector<DataType>::operator=(std::move(rhs));
+        std::swap(ring, rhs.ring);
+        std::swap(numSlots, rhs.numSlots);
+        std::swap(head, rhs.head);
+        std::swap(tail, rhs.tail);
         return *this;
     }
 
-    // insert x into the queue
-    void enqueue(const DataType & x)
+    // makes room for at least newCapacity data elements
+    void reserve(size_t newCapacity)
     {
-        if (size() == (capacity() - 1))
+        if (newCapacity > capacity())
         {
-          reserve(2 * (capacity()) + 1);
+          size_t biggerSlots = capacityFor(newCapacity);
+          adopt(allocateSlots(biggerSlots), biggerSlots);
         }
-        if (dataEnd == (capacity() - 1))
+    }
+
+    // construct a data element in place at the back of the queue
+    // when the queue grows, the new element is constructed before the old ones are moved,
+    // so the arguments may refer to an element of this queue
+    template <typename... Args>
+    void emplace(Args&&... args)
+    {
+        if (size() == capacity())
         {
-          dataEnd = 0;
+          size_t biggerSlots = capacityFor(size() + 1);
+          Slot *bigger = allocateSlots(biggerSlots);
+          new (reinterpret_cast<DataType*>(bigger) + size()) DataType(std::forward<Args>(args)...);
+          adopt(bigger, biggerSlots);
         }
         else
         {
-          dataEnd++;
+          new (at(tail)) DataType(std::forward<Args>(args)...);
         }
-        MyVector<DataType>::insertQueue(x, dataEnd);
+        ++tail;
     }
 
     // insert x into the queue
+    void enqueue(const DataType & x)
+    {
+        emplace(x);
+    }
+
     void enqueue(DataType && x)
     {
-        if (size() == (capacity() - 1))
-        {
-          reserve(2 * (capacity()) + 1);
-        }
-        if (dataEnd == (capacity() - 1))
-        {
-          dataEnd = 0;
-        }
-        else
+        emplace(std::move(x));
+    }
+
+    // insert copies of the data elements [first, last) into the queue, growing at most once
+    // the range must not point into this queue
+    void enqueue_range(const DataType *first, const DataType *last)
+    {
+        size_t n = last - first;
+        reserve(size() + n);
+        for (size_t k = 0; k < n; ++k)
         {
-          dataEnd++;
+          new (at(tail + k)) DataType(first[k]);
         }
-        MyVector<DataType>::insertQueue(std::move(x), dataEnd);
+        tail += n;
     }
 
     // remove the first element from the queue
     void dequeue(void)
     {
-        if (dataStart == (this->capacity() - 1))
-        {
-          dataStart = 0;
-        }
-        else 
+        at(head++)->~DataType();
+    }
+
+    // move up to n data elements from the front of the queue into out; returns how many were moved
+    size_t dequeue_range(DataType *out, size_t n)
+    {
+        n = std::min(n, size());
+        for (size_t k = 0; k < n; ++k)
         {
-          dataStart++;
+          out[k] = std::move(*at(head));
+          dequeue();
         }
+        return n;
     }
 
     // access the first element of the queue
+    DataType & front(void)
+    {
+        return *at(head);
+    }
+
     const DataType & front(void) const
     {
-        return MyVector<DataType>::operator[](this->dataStart);
+        return *at(head);
     }
 
     // check if the queue is empty; return TRUE is empty; FALSE otherwise
     bool empty(void) const
     {
-        if (size() == 0)
-        {
-          return true;
-        }
-        else
-        {
-          return false;
-        }
+        return head == tail;
     }
 
     // access the size of the queue
     size_t size() const
     {
-        int tempSize = dataEnd - dataStart; 
-        if (tempSize == -1 || tempSize == (capacity() - 1))
-        {
-          return 0;
-        }
-        else if (tempSize >= 0)
-        {
-          return (tempSize + 1);
-        }
-        else
-        {
-          return (tempSize + capacity() + 1);
-        }
+        return tail - head;
     }
 
     // access the capacity of the queue
-    size_t capacity(void) const 
+    size_t capacity(void) const
     {
-        return MyVector<DataType>::capacity();
+        return numSlots;
     }
 
 };